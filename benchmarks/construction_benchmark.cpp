@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+#include <chesscxx/game.h>
+#include <chesscxx/parse.h>
+#include <chesscxx/piece_placement.h>
+#include <chesscxx/position.h>
+
+namespace {
+// Default construction copies a cached start position, but the piece
+// location maps inside PiecePlacement are still deep-copied (one allocation
+// per map and set), so these numbers include that allocator traffic.
+void BM_PiecePlacementDefault(benchmark::State& state) {
+  for ([[maybe_unused]] auto ignore : state) {
+    chesscxx::PiecePlacement piece_placement;
+    benchmark::DoNotOptimize(piece_placement);
+  }
+}
+
+void BM_PositionDefault(benchmark::State& state) {
+  for ([[maybe_unused]] auto ignore : state) {
+    chesscxx::Position position;
+    benchmark::DoNotOptimize(position);
+  }
+}
+
+void BM_PositionParamsDefault(benchmark::State& state) {
+  for ([[maybe_unused]] auto ignore : state) {
+    chesscxx::Position::Params params;
+    benchmark::DoNotOptimize(params);
+  }
+}
+
+void BM_GameDefault(benchmark::State& state) {
+  for ([[maybe_unused]] auto ignore : state) {
+    chesscxx::Game game;
+    benchmark::DoNotOptimize(game);
+  }
+}
+
+void BM_GameFromPosition(benchmark::State& state) {
+  auto position = chesscxx::parse<chesscxx::Position>(
+      "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3");
+  if (!position) {
+    state.SkipWithError("invalid benchmark input");
+    return;
+  }
+
+  for ([[maybe_unused]] auto ignore : state) {
+    chesscxx::Game game(*position);
+    benchmark::DoNotOptimize(game);
+  }
+}
+}  // namespace
+
+BENCHMARK(BM_PiecePlacementDefault)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_PositionDefault)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_PositionParamsDefault)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_GameDefault)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_GameFromPosition)->Unit(benchmark::kNanosecond);
+
+BENCHMARK_MAIN();
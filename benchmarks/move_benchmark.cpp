@@ -0,0 +1,287 @@
+#include <benchmark/benchmark.h>
+#include <chesscxx/core/internal/move_record.h>
+#include <chesscxx/core/internal/position.h>
+#include <chesscxx/core/internal/position_modifier.h>
+#include <chesscxx/game.h>
+#include <chesscxx/parse.h>
+#include <chesscxx/position.h>
+#include <chesscxx/san_move.h>
+#include <chesscxx/uci_move.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace {
+struct GameRecord {
+  chesscxx::Position initial_position;
+  std::vector<chesscxx::Position> positions;
+  std::vector<chesscxx::UciMove> uci_moves;
+  std::vector<chesscxx::SanMove> san_moves;
+};
+
+auto LoadGameRecords() -> std::vector<GameRecord> {
+  std::ifstream file("data/games.pgn", std::ios::binary);
+  if (!file) return {};
+
+  std::vector<char> buffer{std::istreambuf_iterator<char>{file},
+                           std::istreambuf_iterator<char>{}};
+
+  auto rit = std::ranges::find_if_not(
+      std::ranges::reverse_view(buffer),
+      [](unsigned char character) { return std::isspace(character); });
+
+  std::string_view const str(buffer.begin(), rit.base());
+
+  std::vector<GameRecord> records;
+
+  for (const auto* it = str.begin(); it != str.end();) {
+    auto result = chesscxx::parseFrom<chesscxx::Game>(it, str.end());
+    if (!result) return {};
+    it = result->ptr;
+
+    const auto& game = result->parsed_value;
+
+    GameRecord record{
+        .initial_position = game.initialPosition(),
+        .positions = {},
+        .uci_moves = game.uciMoves(),
+        .san_moves = game.sanMoves(),
+    };
+
+    chesscxx::Game replay(game.initialPosition());
+    for (const auto& uci_move : record.uci_moves) {
+      record.positions.push_back(replay.currentPosition());
+      if (!replay.move(uci_move)) return {};
+    }
+
+    records.push_back(std::move(record));
+  }
+
+  return records;
+}
+
+auto GameRecords() -> const std::vector<GameRecord>& {
+  static const auto kRecords = LoadGameRecords();
+  return kRecords;
+}
+
+auto TotalMoves(const std::vector<GameRecord>& records) -> int64_t {
+  int64_t total = 0;
+  for (const auto& record : records) {
+    total += static_cast<int64_t>(record.uci_moves.size());
+  }
+  return total;
+}
+
+void SetMovesCounter(benchmark::State& state, int64_t moves) {
+  state.counters["moves"] = benchmark::Counter(
+      static_cast<double>(moves),
+      benchmark::Counter::kIsIterationInvariantRate);
+}
+
+template <typename MoveNotation>
+auto MovesOf(const GameRecord& record) -> const std::vector<MoveNotation>& {
+  if constexpr (std::is_same_v<MoveNotation, chesscxx::SanMove>) {
+    return record.san_moves;
+  } else {
+    return record.uci_moves;
+  }
+}
+
+template <typename MoveNotation>
+void BM_PositionModifierMakeUnmake(benchmark::State& state) {
+  using chesscxx::internal::PositionModifier;
+
+  const auto& records = GameRecords();
+  if (records.empty()) {
+    state.SkipWithError("unable to load data/games.pgn");
+    return;
+  }
+
+  std::vector<chesscxx::internal::MoveRecord> history;
+
+  for ([[maybe_unused]] auto ignore : state) {
+    for (const auto& record : records) {
+      auto position = record.initial_position;
+
+      for (const auto& move : MovesOf<MoveNotation>(record)) {
+        auto move_record = PositionModifier::move(position, move);
+        if (!move_record) std::abort();
+        history.push_back(*move_record);
+      }
+
+      for (const auto& move_record : std::views::reverse(history)) {
+        PositionModifier::undoMove(position, move_record);
+      }
+
+      history.clear();
+      benchmark::DoNotOptimize(position);
+    }
+  }
+
+  SetMovesCounter(state, TotalMoves(records));
+}
+
+void BM_UciFromSan(benchmark::State& state) {
+  const auto& records = GameRecords();
+  if (records.empty()) {
+    state.SkipWithError("unable to load data/games.pgn");
+    return;
+  }
+
+  int64_t resolved = 0;
+
+  for ([[maybe_unused]] auto ignore : state) {
+    resolved = 0;
+
+    for (const auto& record : records) {
+      for (const auto& [position, san_move] :
+           std::views::zip(record.positions, record.san_moves)) {
+        const auto* normal_move =
+            std::get_if<chesscxx::SanNormalMove>(&san_move);
+        if (normal_move == nullptr) continue;
+
+        auto uci_move = chesscxx::internal::uciFromSan(
+            position, *normal_move, position.activeColor());
+        benchmark::DoNotOptimize(uci_move);
+        resolved++;
+      }
+    }
+  }
+
+  SetMovesCounter(state, resolved);
+}
+
+template <typename MoveNotation>
+void BM_GameMove(benchmark::State& state) {
+  const auto& records = GameRecords();
+  if (records.empty()) {
+    state.SkipWithError("unable to load data/games.pgn");
+    return;
+  }
+
+  std::vector<chesscxx::Game> games;
+  for (const auto& record : records) {
+    games.emplace_back(record.initial_position);
+  }
+
+  for ([[maybe_unused]] auto ignore : state) {
+    state.PauseTiming();
+    for (auto& game : games) game.reset();
+    state.ResumeTiming();
+
+    for (auto [game, record] : std::views::zip(games, records)) {
+      for (const auto& move : MovesOf<MoveNotation>(record)) {
+        if (!game.move(move)) std::abort();
+      }
+    }
+  }
+
+  SetMovesCounter(state, TotalMoves(records));
+}
+
+void BM_GameUndoMove(benchmark::State& state) {
+  const auto& records = GameRecords();
+  if (records.empty()) {
+    state.SkipWithError("unable to load data/games.pgn");
+    return;
+  }
+
+  std::vector<chesscxx::Game> games;
+  for (const auto& record : records) {
+    games.emplace_back(record.initial_position);
+  }
+
+  for ([[maybe_unused]] auto ignore : state) {
+    state.PauseTiming();
+    for (auto [game, record] : std::views::zip(games, records)) {
+      for (const auto& move : record.uci_moves) {
+        if (!game.move(move)) std::abort();
+      }
+    }
+    state.ResumeTiming();
+
+    for (auto [game, record] : std::views::zip(games, records)) {
+      for ([[maybe_unused]] const auto& move : record.uci_moves) {
+        game.undoMove();
+      }
+    }
+  }
+
+  SetMovesCounter(state, TotalMoves(records));
+}
+
+template <class... Args>
+void BM_PositionModifierSingleMove(benchmark::State& state, Args&&... args) {
+  using chesscxx::internal::PositionModifier;
+
+  auto args_tuple = std::make_tuple(std::forward<Args>(args)...);
+  auto [fen, move_str] = args_tuple;
+
+  auto position = chesscxx::parse<chesscxx::Position>(fen);
+  auto move = chesscxx::parse<chesscxx::UciMove>(move_str);
+
+  if (!position || !move) {
+    state.SkipWithError("invalid benchmark input");
+    return;
+  }
+
+  for ([[maybe_unused]] auto ignore : state) {
+    auto move_record = PositionModifier::move(*position, *move);
+    if (!move_record) std::abort();
+    PositionModifier::undoMove(*position, *move_record);
+    benchmark::DoNotOptimize(*position);
+  }
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_PositionModifierMakeUnmake, chesscxx::UciMove)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PositionModifierMakeUnmake, chesscxx::SanMove)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_UciFromSan)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GameMove, chesscxx::UciMove)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GameMove, chesscxx::SanMove)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GameUndoMove)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_PositionModifierSingleMove, kingside_castling,
+                  "r3k2r/pppq1ppp/2npbn2/2b1p3/2B1P3/2NPBN2/PPPQ1PPP/R3K2R w "
+                  "KQkq - 4 8",
+                  "e1g1")
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_PositionModifierSingleMove, queenside_castling,
+                  "r3k2r/pppq1ppp/2npbn2/2b1p3/2B1P3/2NPBN2/PPPQ1PPP/R3K2R w "
+                  "KQkq - 4 8",
+                  "e1c1")
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_PositionModifierSingleMove, en_passant_capture,
+                  "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 "
+                  "0 3",
+                  "e5f6")
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_PositionModifierSingleMove, promotion,
+                  "8/1P3k2/8/8/8/8/5K2/8 w - - 0 1", "b7b8q")
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_PositionModifierSingleMove, quiet_move,
+                  "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+                  "g1f3")
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -2,7 +2,9 @@
 #include <chesscxx/game.h>
 #include <chesscxx/movegen.h>
 #include <chesscxx/parse.h>
+#include <chesscxx/transposition_table.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <utility>
@@ -22,6 +24,34 @@ auto Perft(chesscxx::Game& game, int64_t depth) -> int64_t {
   return nodes;
 }
 
+struct PerftEntry {
+  int64_t nodes;
+  int64_t depth;
+};
+
+using PerftTable = chesscxx::TranspositionTable<PerftEntry>;
+
+auto HashedPerft(chesscxx::Game& game, int64_t depth, PerftTable& table)
+    -> int64_t {
+  if (depth == 0) return 1ULL;
+
+  auto key = game.currentPosition().zobristKey();
+  if (auto entry = table.probe(key); entry && entry->depth == depth) {
+    return entry->nodes;
+  }
+
+  int64_t nodes = 0;
+
+  for (auto uci_move : chesscxx::legalUciMoves(game)) {
+    std::ignore = game.move(uci_move);
+    nodes += HashedPerft(game, depth - 1, table);
+    game.undoMove();
+  }
+
+  table.store(key, {.nodes = nodes, .depth = depth});
+  return nodes;
+}
+
 template <class... Args>
 void BM_Perft(benchmark::State& state, Args&&... args) {
   auto args_tuple = std::make_tuple(std::forward<Args>(args)...);
@@ -38,6 +68,26 @@ void BM_Perft(benchmark::State& state, Args&&... args) {
     }
   }
 }
+
+template <class... Args>
+void BM_HashedPerft(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::forward<Args>(args)...);
+  auto [fen, depth, expected_result] = args_tuple;
+
+  auto parsed_game =
+      chesscxx::parse<chesscxx::Game>(fen, chesscxx::parse_as::Fen{});
+
+  if (!parsed_game) return;
+
+  PerftTable table(size_t{16} << 20U);
+
+  for ([[maybe_unused]] auto ignore : state) {
+    table.clear();
+    if (HashedPerft(parsed_game.value(), depth, table) != expected_result) {
+      std::abort();
+    }
+  }
+}
 }  // namespace
 
 BENCHMARK_CAPTURE(BM_Perft, position_1,
@@ -72,4 +122,15 @@ BENCHMARK_CAPTURE(
     3, 89890)
     ->Unit(benchmark::kMillisecond);
 
+BENCHMARK_CAPTURE(BM_HashedPerft, position_1,
+                  "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 4,
+                  197281)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(
+    BM_HashedPerft, position_2,
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3,
+    97862)
+    ->Unit(benchmark::kMillisecond);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,206 @@
+#include <benchmark/benchmark.h>
+#include <chesscxx/game.h>
+#include <chesscxx/movegen.h>
+#include <chesscxx/parse.h>
+#include <chesscxx/san_move.h>
+#include <chesscxx/uci_move.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <random>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace {
+constexpr int kCorpusGames = 256;
+constexpr int kMaxPlies = 200;
+constexpr uint32_t kCorpusSeed = 20250224;
+
+struct Corpus {
+  // Complete PGN documents separated by blank lines.
+  std::string pgn;
+  // The tag sections of the same documents, each with an empty move list.
+  std::string tags;
+  // Every SAN token of every game, as written in the move text.
+  std::vector<std::string> san_tokens;
+  // The parsed move list of every game, ready to be replayed.
+  std::vector<std::vector<chesscxx::SanMove>> san_moves;
+};
+
+// Plays uniformly random legal moves. The candidates are sorted first so that
+// the corpus does not depend on the order in which moves are generated.
+auto RandomGame(std::mt19937& rng) -> chesscxx::Game {
+  chesscxx::Game game;
+  std::vector<chesscxx::UciMove> moves;
+
+  auto move_key = [](const chesscxx::UciMove& move) {
+    return std::tuple(move.origin.rank, move.origin.file,
+                      move.destination.rank, move.destination.file,
+                      move.promotion);
+  };
+
+  for (int ply = 0; ply < kMaxPlies && !game.result(); ++ply) {
+    moves = chesscxx::legalUciMoves(game) |
+            std::ranges::to<std::vector<chesscxx::UciMove>>();
+    std::ranges::sort(moves, {}, move_key);
+
+    if (!game.move(moves[rng() % moves.size()])) std::abort();
+  }
+
+  return game;
+}
+
+auto TagSection(int index) -> std::string {
+  constexpr int kBaseElo = 1200;
+  constexpr int kEloSpread = 1600;
+
+  return std::format(
+      "[Event \"Synthetic self-play\"]\n"
+      "[Site \"chesscxx\"]\n"
+      "[Date \"2025.02.24\"]\n"
+      "[Round \"{}\"]\n"
+      "[White \"Random player {}\"]\n"
+      "[Black \"Random player {}\"]\n"
+      "[WhiteElo \"{}\"]\n"
+      "[BlackElo \"{}\"]\n"
+      "[TimeControl \"300+0\"]\n",
+      index + 1, 2 * index, (2 * index) + 1,
+      kBaseElo + ((index * 37) % kEloSpread),
+      kBaseElo + ((index * 53) % kEloSpread));
+}
+
+auto GenerateCorpus() -> Corpus {
+  std::mt19937 rng(kCorpusSeed);
+  Corpus corpus;
+
+  for (int index = 0; index < kCorpusGames; ++index) {
+    auto game = RandomGame(rng);
+    auto tags = TagSection(index);
+
+    if (index != 0) {
+      corpus.pgn += "\n\n";
+      corpus.tags += "\n\n";
+    }
+
+    corpus.pgn += tags;
+    corpus.pgn += std::format("{}", game);
+    corpus.tags += tags;
+    corpus.tags += "\n*";
+
+    for (const auto& san_move : game.sanMoves()) {
+      corpus.san_tokens.push_back(std::format("{}", san_move));
+    }
+    corpus.san_moves.push_back(game.sanMoves());
+  }
+
+  return corpus;
+}
+
+auto GetCorpus() -> const Corpus& {
+  static const auto kCorpus = GenerateCorpus();
+  return kCorpus;
+}
+
+void SetRateCounter(benchmark::State& state, const std::string& name,
+                    int64_t value,
+                    benchmark::Counter::OneK one_k =
+                        benchmark::Counter::OneK::kIs1000) {
+  state.counters[name] = benchmark::Counter(
+      static_cast<double>(value), benchmark::Counter::kIsIterationInvariantRate,
+      one_k);
+}
+
+auto ParseGames(std::string_view str) -> int64_t {
+  int64_t games = 0;
+
+  for (const auto* it = str.begin(); it != str.end();) {
+    auto result = chesscxx::parseFrom<chesscxx::Game>(
+        it, str.end(), chesscxx::parse_as::Pgn{});
+    if (!result) std::abort();
+
+    benchmark::DoNotOptimize(result->parsed_value);
+    it = result->ptr;
+    games++;
+  }
+
+  return games;
+}
+
+void BM_PgnParse(benchmark::State& state) {
+  const auto& corpus = GetCorpus();
+  int64_t games = 0;
+
+  for ([[maybe_unused]] auto ignore : state) {
+    games = ParseGames(corpus.pgn);
+  }
+
+  SetRateCounter(state, "bytes", static_cast<int64_t>(corpus.pgn.size()),
+                 benchmark::Counter::OneK::kIs1024);
+  SetRateCounter(state, "games", games);
+}
+
+void BM_PgnTagParse(benchmark::State& state) {
+  const auto& corpus = GetCorpus();
+  int64_t games = 0;
+
+  for ([[maybe_unused]] auto ignore : state) {
+    games = ParseGames(corpus.tags);
+  }
+
+  SetRateCounter(state, "bytes", static_cast<int64_t>(corpus.tags.size()),
+                 benchmark::Counter::OneK::kIs1024);
+  SetRateCounter(state, "games", games);
+}
+
+void BM_SanTokenize(benchmark::State& state) {
+  const auto& corpus = GetCorpus();
+  int64_t bytes = 0;
+
+  for (const auto& token : corpus.san_tokens) {
+    bytes += static_cast<int64_t>(token.size());
+  }
+
+  for ([[maybe_unused]] auto ignore : state) {
+    for (const auto& token : corpus.san_tokens) {
+      auto result = chesscxx::parseFrom<chesscxx::SanMove>(
+          token.data(), token.data() + token.size());
+      if (!result) std::abort();
+      benchmark::DoNotOptimize(result->parsed_value);
+    }
+  }
+
+  SetRateCounter(state, "bytes", bytes, benchmark::Counter::OneK::kIs1024);
+  SetRateCounter(state, "moves",
+                 static_cast<int64_t>(corpus.san_tokens.size()));
+}
+
+void BM_SanReplay(benchmark::State& state) {
+  const auto& corpus = GetCorpus();
+
+  for ([[maybe_unused]] auto ignore : state) {
+    for (const auto& san_moves : corpus.san_moves) {
+      chesscxx::Game game;
+      for (const auto& san_move : san_moves) {
+        if (!game.move(san_move)) std::abort();
+      }
+      benchmark::DoNotOptimize(game);
+    }
+  }
+
+  SetRateCounter(state, "games", kCorpusGames);
+  SetRateCounter(state, "moves",
+                 static_cast<int64_t>(corpus.san_tokens.size()));
+}
+}  // namespace
+
+BENCHMARK(BM_PgnParse)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PgnTagParse)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SanTokenize)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SanReplay)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,41 @@
+#include <chesscxx/endgame.h>
+#include <chesscxx/parse.h>
+#include <chesscxx/position.h>
+
+#include <cstdlib>
+#include <print>
+#include <string_view>
+
+namespace {
+void verify(const auto& check) {
+  if (!static_cast<bool>(check)) std::abort();
+}
+auto parsePosition(std::string_view str) -> chesscxx::Position {
+  auto parsed_position = chesscxx::parse<chesscxx::Position>(str);
+  verify(parsed_position);
+
+  return parsed_position.value();
+}
+auto toString(chesscxx::BitbaseResult result) -> std::string_view {
+  return result == chesscxx::BitbaseResult::kWin ? "win" : "draw";
+}
+}  // namespace
+
+auto main() -> int {
+  // Whoever has to move here loses the opposition.
+  for (auto fen : {"8/4k3/8/4K3/4P3/8/8/8 w - - 0 1",
+                   "8/4k3/8/4K3/4P3/8/8/8 b - - 0 1"}) {
+    auto result = chesscxx::probeKPK(parsePosition(fen));
+    verify(result);
+    std::println("{}: {}", fen, toString(*result));
+  }
+
+  // Rook pawns are drawn once the defending king reaches the corner.
+  auto result =
+      chesscxx::probeKPK(parsePosition("k7/8/8/8/8/8/P7/K7 w - - 0 1"));
+  verify(result);
+  std::println("rook pawn: {}", toString(*result));
+
+  // Other material is not in the bitbase.
+  std::println("{}", chesscxx::probeKPK(chesscxx::Position()).has_value());
+}
@@ -0,0 +1,78 @@
+#include <chesscxx/board_observer.h>
+#include <chesscxx/color.h>
+#include <chesscxx/game.h>
+#include <chesscxx/parse.h>
+#include <chesscxx/piece.h>
+#include <chesscxx/piece_type.h>
+#include <chesscxx/san_move.h>
+#include <chesscxx/square.h>
+
+#include <cstdlib>
+#include <print>
+#include <string_view>
+
+namespace {
+void verify(const auto& check) {
+  if (!static_cast<bool>(check)) std::abort();
+}
+auto parseSanMove(std::string_view str) -> chesscxx::SanMove {
+  auto parsed_san_move = chesscxx::parse<chesscxx::SanMove>(str);
+  verify(parsed_san_move);
+  return parsed_san_move.value();
+}
+
+// Keeps the material balance, in pawns, from white's point of view.
+class MaterialObserver {
+ public:
+  void onAdd(const chesscxx::Piece& piece, const chesscxx::Square& /*sq*/) {
+    balance_ += value(piece);
+  }
+  void onRemove(const chesscxx::Piece& piece, const chesscxx::Square& /*sq*/) {
+    balance_ -= value(piece);
+  }
+  void onMove(const chesscxx::Piece& /*piece*/,
+              const chesscxx::Square& /*origin*/,
+              const chesscxx::Square& /*destination*/) {}
+
+  [[nodiscard]] auto balance() const -> int { return balance_; }
+
+ private:
+  static auto value(const chesscxx::Piece& piece) -> int {
+    int value = 0;
+    switch (piece.type) {
+      case chesscxx::PieceType::kPawn:
+        value = 1;
+        break;
+      case chesscxx::PieceType::kKnight:
+      case chesscxx::PieceType::kBishop:
+        value = 3;
+        break;
+      case chesscxx::PieceType::kRook:
+        value = 5;
+        break;
+      case chesscxx::PieceType::kQueen:
+        value = 9;
+        break;
+      case chesscxx::PieceType::kKing:
+        break;
+    }
+    return piece.color == chesscxx::Color::kWhite ? value : -value;
+  }
+
+  int balance_ = 0;
+};
+}  // namespace
+
+auto main() -> int {
+  chesscxx::Game game;
+  MaterialObserver observer;
+  chesscxx::addPieces(game.piecePlacement(), observer);
+
+  for (auto str : {"e4", "d5", "exd5", "Qxd5", "Nc3", "Qxg2", "Bxg2"}) {
+    verify(game.move(parseSanMove(str), observer));
+    std::println("{} {}", str, observer.balance());
+  }
+
+  game.undoMove(observer);
+  std::println("undo {}", observer.balance());
+}
@@ -53,6 +53,9 @@ auto main() -> int {
   move(game, "Nb1");
   printRepetition(game);
 
+  // Nb8 brings the initial position about for the third time.
+  verify(chesscxx::hasUpcomingRepetition(game));
+
   move(game, "Nb8");
   printRepetition(game);
 
@@ -0,0 +1,47 @@
+#include <chesscxx/parse.h>
+#include <chesscxx/position.h>
+#include <chesscxx/search.h>
+#include <chesscxx/uci_move.h>
+
+#include <cstdlib>
+#include <print>
+#include <string_view>
+#include <vector>
+
+namespace {
+void verify(const auto& check) {
+  if (!static_cast<bool>(check)) std::abort();
+}
+auto parsePosition(std::string_view str) -> chesscxx::Position {
+  auto parsed_position = chesscxx::parse<chesscxx::Position>(str);
+  verify(parsed_position);
+
+  return parsed_position.value();
+}
+}  // namespace
+
+auto main() -> int {
+  std::vector<chesscxx::Position> const puzzles = {
+      parsePosition("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1"),
+      parsePosition("2k5/8/1K6/8/8/8/8/7R w - - 0 1"),
+      parsePosition("r5k1/5ppp/8/8/8/8/5PPP/R5K1 b - - 0 1"),
+      chesscxx::Position(),
+  };
+
+  // Each thread solves whole positions with its own table.
+  auto results = chesscxx::solveMates(puzzles, 5, 1'000'000, 2);
+
+  for (const auto& result : results) {
+    switch (result.status) {
+      case chesscxx::MateStatus::kProven:
+        std::println("mate in {}: {}", *result.mateIn(), result.line);
+        break;
+      case chesscxx::MateStatus::kDisproven:
+        std::println("no mate in 3");
+        break;
+      case chesscxx::MateStatus::kUnknown:
+        std::println("gave up after {} nodes", result.nodes);
+        break;
+    }
+  }
+}
@@ -0,0 +1,36 @@
+#include <chesscxx/game.h>
+#include <chesscxx/movegen.h>
+#include <chesscxx/parse.h>
+#include <chesscxx/uci_move.h>
+
+#include <cstdlib>
+#include <print>
+#include <string_view>
+
+namespace {
+void verify(const auto& check) {
+  if (!static_cast<bool>(check)) std::abort();
+}
+auto parseFen(std::string_view str) -> chesscxx::Game {
+  auto parsed_game =
+      chesscxx::parse<chesscxx::Game>(str, chesscxx::parse_as::Fen{});
+  verify(parsed_game);
+
+  return parsed_game.value();
+}
+}  // namespace
+
+auto main() -> int {
+  chesscxx::Game const game = parseFen("3r2k1/8/8/3r4/8/8/3R4/3Q2K1 w - - 0 1");
+  const auto& position = game.currentPosition();
+
+  std::println("{:fen}", game);
+
+  // The queen behind the rook on d2 joins the exchange once the rook has
+  // recaptured on d5.
+  auto captures = chesscxx::legalUciMoves<chesscxx::GenType::kCaptures>(game);
+  for (auto move : captures) {
+    std::println("{} {} {}", move, chesscxx::see(position, move),
+                 chesscxx::seeGreaterOrEqual(position, move, 0));
+  }
+}
@@ -0,0 +1,37 @@
+#include <chesscxx/game.h>
+#include <chesscxx/movegen.h>
+#include <chesscxx/parse.h>
+
+#include <cstdlib>
+#include <print>
+#include <ranges>
+#include <string_view>
+
+namespace {
+void verify(const auto& check) {
+  if (!static_cast<bool>(check)) std::abort();
+}
+auto parseFen(std::string_view str) -> chesscxx::Game {
+  auto parsed_game =
+      chesscxx::parse<chesscxx::Game>(str, chesscxx::parse_as::Fen{});
+  verify(parsed_game);
+
+  return parsed_game.value();
+}
+}  // namespace
+
+auto main() -> int {
+  chesscxx::Game const game = parseFen(
+      "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+
+  std::println("{:fen}", game);
+
+  // Captures and promotions, best MVV-LVA score first. Quiet moves are never
+  // generated because the generator is not resumed past the first stage.
+  auto best_captures =
+      chesscxx::stagedLegalUciMoves(game, chesscxx::mvvLvaScore) |
+      std::views::take(3);
+  std::println("{}", best_captures);
+
+  std::println("{}", chesscxx::stagedLegalUciMoves(game));
+}
@@ -0,0 +1,42 @@
+#include <chesscxx/game.h>
+#include <chesscxx/movegen.h>
+#include <chesscxx/parse.h>
+#include <chesscxx/uci_move.h>
+
+#include <cstdlib>
+#include <print>
+#include <string_view>
+
+namespace {
+void verify(const auto& check) {
+  if (!static_cast<bool>(check)) std::abort();
+}
+auto parseFen(std::string_view str) -> chesscxx::Game {
+  auto parsed_game =
+      chesscxx::parse<chesscxx::Game>(str, chesscxx::parse_as::Fen{});
+  verify(parsed_game);
+
+  return parsed_game.value();
+}
+auto parseUciMove(std::string_view str) -> chesscxx::UciMove {
+  auto parsed_move = chesscxx::parse<chesscxx::UciMove>(str);
+  verify(parsed_move);
+
+  return parsed_move.value();
+}
+}  // namespace
+
+auto main() -> int {
+  chesscxx::Game const game = parseFen("4k3/8/8/b7/8/2N5/8/4K1N1 w - - 0 1");
+  const auto& position = game.currentPosition();
+
+  std::println("{:fen}", game);
+
+  // The knight on c3 is pinned by the bishop on a5, so only the knight on g1
+  // may go to e2. A knight cannot reach g3 from g1 at all.
+  for (auto str : {"g1e2", "c3e2", "e1d2", "g1g3"}) {
+    auto move = parseUciMove(str);
+    std::println("{} {} {}", move, chesscxx::isPseudoLegal(position, move),
+                 chesscxx::isLegal(position, move));
+  }
+}
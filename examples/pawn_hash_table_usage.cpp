@@ -0,0 +1,64 @@
+#include <chesscxx/color.h>
+#include <chesscxx/file.h>
+#include <chesscxx/game.h>
+#include <chesscxx/parse.h>
+#include <chesscxx/pawn_hash_table.h>
+#include <chesscxx/piece_type.h>
+#include <chesscxx/position.h>
+#include <chesscxx/uci_move.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <print>
+#include <string_view>
+
+namespace {
+void verify(const auto& check) {
+  if (!static_cast<bool>(check)) std::abort();
+}
+auto parseUciMove(std::string_view str) -> chesscxx::UciMove {
+  auto parsed_move = chesscxx::parse<chesscxx::UciMove>(str);
+  verify(parsed_move);
+
+  return parsed_move.value();
+}
+// The cached value: pawns standing on a file behind another pawn of their
+// color.
+auto countDoubledPawns(const chesscxx::Position& position) -> int {
+  std::array<std::array<int, chesscxx::kNumFiles>, 2> pawns_per_file{};
+  const auto& piece_array = position.piecePlacement().pieceArray();
+  for (size_t i = 0; i < piece_array.size(); ++i) {
+    const auto& piece = piece_array.at(i);
+    if (piece && piece->type == chesscxx::PieceType::kPawn) {
+      auto color = piece->color == chesscxx::Color::kWhite ? 0 : 1;
+      ++pawns_per_file.at(color).at(i % chesscxx::kNumFiles);
+    }
+  }
+
+  int count = 0;
+  for (const auto& files : pawns_per_file) {
+    for (auto pawns : files) count += pawns > 1 ? pawns - 1 : 0;
+  }
+  return count;
+}
+}  // namespace
+
+auto main() -> int {
+  chesscxx::PawnHashTable<int, 1024> table;
+  chesscxx::Game game;
+
+  for (auto str :
+       {"e2e4", "e7e5", "g1f3", "b8c6", "f1b5", "a7a6", "b5c6", "d7c6"}) {
+    verify(game.move(parseUciMove(str)));
+
+    // Knight and bishop moves keep the pawn key, so their positions share the
+    // entry stored for the last pawn move.
+    const auto& position = game.currentPosition();
+    const auto* entry = table.probe(position);
+    bool const hit = entry != nullptr;
+    if (!hit) entry = &table.store(position, countDoubledPawns(position));
+
+    std::println("{} {} doubled pawns: {}", str, hit ? "hit " : "miss", *entry);
+  }
+}
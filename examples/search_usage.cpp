@@ -0,0 +1,37 @@
+#include <chesscxx/game.h>
+#include <chesscxx/parse.h>
+#include <chesscxx/search.h>
+#include <chesscxx/uci_move.h>
+
+#include <cstdlib>
+#include <print>
+#include <string_view>
+
+namespace {
+void verify(const auto& check) {
+  if (!static_cast<bool>(check)) std::abort();
+}
+auto parseFen(std::string_view str) -> chesscxx::Game {
+  auto parsed_game =
+      chesscxx::parse<chesscxx::Game>(str, chesscxx::parse_as::Fen{});
+  verify(parsed_game);
+
+  return parsed_game.value();
+}
+}  // namespace
+
+auto main() -> int {
+  chesscxx::Game const game = parseFen("2k5/8/1K6/8/8/8/8/7R w - - 0 1");
+  std::println("{:fen}", game);
+
+  chesscxx::Searcher<> searcher;
+  auto result = searcher.search(
+      game, {.depth = 8}, [](const chesscxx::SearchResult& iteration) {
+        std::println("depth {} score {} pv {}", iteration.depth,
+                     iteration.score, iteration.pv);
+      });
+
+  verify(result.best_move);
+  std::println("best move {}", *result.best_move);
+  std::println("mate in {}", result.mateIn().value_or(0));
+}
@@ -0,0 +1,6 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_BOARD_OBSERVER_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_BOARD_OBSERVER_H_
+
+#include "core/board_observer.h"  // IWYU pragma: export
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_BOARD_OBSERVER_H_
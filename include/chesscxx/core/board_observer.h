@@ -0,0 +1,53 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_CORE_BOARD_OBSERVER_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_CORE_BOARD_OBSERVER_H_
+
+// IWYU pragma: private, include "../board_observer.h"
+
+#include <cstddef>
+
+#include "../piece.h"
+#include "../piece_placement.h"
+#include "../square.h"
+#include "internal/bitboard.h"
+
+namespace chesscxx {
+
+/// @defgroup BoardObserverGroup Board observers
+/// @{
+
+/// @brief A type notified of every piece change made by a move, so that it
+/// can keep state derived from the board, such as a piece-square evaluation,
+/// up to date incrementally.
+///
+/// - `onAdd(piece, square)` is called when a piece appears on an empty square:
+///   a captured piece put back by an undo, or a promoted piece.
+/// - `onRemove(piece, square)` is called when a piece leaves the board: a
+///   captured piece, or a pawn that promotes.
+/// - `onMove(piece, origin, destination)` is called when a piece goes from one
+///   square to another. The destination is empty by then: a captured piece is
+///   reported by onRemove() first.
+template <typename T>
+concept BoardObserver = requires(T& observer, const Piece& piece,
+                                 const Square& square) {
+  observer.onAdd(piece, square);
+  observer.onRemove(piece, square);
+  observer.onMove(piece, square, square);
+};
+
+/// @brief Calls `observer.onAdd(piece, square)` for every piece of the piece
+/// placement, to set up an observer before it follows the moves of a game.
+template <BoardObserver Observer>
+void addPieces(const PiecePlacement& piece_placement, Observer& observer) {
+  const auto& piece_array = piece_placement.pieceArray();
+  for (size_t i = 0; i < piece_array.size(); ++i) {
+    if (const auto& piece = piece_array.at(i)) {
+      observer.onAdd(*piece, internal::squareFromIndex(i));
+    }
+  }
+}
+
+/// @}
+
+}  // namespace chesscxx
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_CORE_BOARD_OBSERVER_H_
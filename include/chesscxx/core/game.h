@@ -3,12 +3,18 @@
 
 // IWYU pragma: private, include "../game.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <expected>
+#include <iterator>
 #include <optional>
+#include <ranges>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
+#include "../board_observer.h"
 #include "../castling_rights.h"
 #include "../color.h"
 #include "../draw_reason.h"
@@ -19,7 +25,9 @@
 #include "../position.h"
 #include "../san_move.h"
 #include "../square.h"
+#include "../stats.h"
 #include "../uci_move.h"
+#include "internal/board_observer.h"
 #include "internal/move_record.h"
 #include "internal/position.h"
 #include "internal/position_modifier.h"
@@ -39,12 +47,12 @@ class Game {
 
   /// @brief Default constructor. Constructs a new game starting from the
   /// default position.
-  constexpr Game() { updateRepetitionTracker(); }
+  Game() { updateRepetitionTracker(); }
 
   /// @brief Constructs a new game with a specified initial position.
-  constexpr explicit Game(const Position& initial_position)
+  explicit Game(const Position& initial_position)
       : initial_position_(initial_position),
-        is_default_start_(initial_position == Position{}),
+        is_default_start_(initial_position == defaultPosition()),
         current_position_(initial_position) {
     updateRepetitionTracker();
   }
@@ -57,7 +65,8 @@ class Game {
   /// @brief Equality comparison operator.
   constexpr auto operator==(const Game& other) const -> bool {
     return initial_position_ == other.initial_position_ &&
-           uci_move_history_ == other.uci_move_history_;
+           uci_move_history_ == other.uci_move_history_ &&
+           null_move_history_.size() == other.null_move_history_.size();
   }
 
   /// @}
@@ -115,7 +124,26 @@ class Game {
     return san_move_history_;
   }
 
-  /// @brief Returns the repetition tracker.
+  /// @brief Returns the Zobrist keys of the positions the game went through,
+  /// from the initial position to the current one. A null move adds a key as
+  /// a move does.
+  auto zobristKeys() const -> const std::vector<uint64_t>& {
+    return zobrist_keys_;
+  }
+
+  /// @brief Returns the number of plies played since the last null move, or
+  /// since the initial position if no null move is in play. Positions before
+  /// a null move cannot occur again on the board, so repetitions are only
+  /// looked for within these plies.
+  auto pliesSinceNullMove() const -> size_t {
+    auto plies = move_history_.size();
+    if (null_move_history_.empty()) return plies;
+
+    return plies - null_move_history_.back().ply;
+  }
+
+  /// @brief Returns the repetition tracker. Positions reached after a null
+  /// move are left out of it.
   auto repetitionTracker() const -> const RepetitionTracker& {
     return repetition_tracker_;
   }
@@ -158,9 +186,59 @@ class Game {
   auto move(const SanMove& move) -> std::expected<void, MoveError> {
     return executeMove(move);
   }
+  /// @brief Applies a move as move() does, and reports the pieces it adds,
+  /// removes and moves to the observer. Nothing is reported if the move is
+  /// illegal.
+  template <BoardObserver Observer>
+  auto move(const UciMove& move, Observer& observer)
+      -> std::expected<void, MoveError> {
+    return executeMove(move, observer);
+  }
+  /// @brief Applies a move as move() does, and reports the pieces it adds,
+  /// removes and moves to the observer. Nothing is reported if the move is
+  /// illegal.
+  template <BoardObserver Observer>
+  auto move(const SanMove& move, Observer& observer)
+      -> std::expected<void, MoveError> {
+    return executeMove(move, observer);
+  }
+
+  /// @brief Passes the turn to the opponent without moving a piece, as null
+  /// move pruning and threat detection in a search do. The en passant target
+  /// square is cleared and the move counters advance as for a quiet move. A
+  /// null move is not recorded in uciMoves() or sanMoves(), and should be
+  /// undone before the game is compared or formatted. Until it is undone,
+  /// repetitions only count the positions reached after it.
+  /// @return An error if the side to move is in check or a move counter would
+  /// overflow.
+  auto makeNullMove() -> std::expected<void, MoveError> {
+    auto result = internal::PositionModifier::makeNullMove(current_position_);
+    if (!result) return std::unexpected(result.error());
+
+    null_move_history_.push_back(
+        {.record = *result, .ply = move_history_.size()});
+    updateRepetitionTracker();
+    return {};
+  }
 
-  /// @brief Undoes the last move played, restoring the previous position.
+  /// @brief Undoes the last null move, if it is the last thing played.
+  void undoNullMove() {
+    if (!lastIsNullMove()) return;
+
+    removePositionOccurrence();
+    internal::PositionModifier::undoNullMove(current_position_,
+                                             null_move_history_.back().record);
+    null_move_history_.pop_back();
+  }
+
+  /// @brief Undoes the last move played, restoring the previous position. A
+  /// null move played last is undone as by undoNullMove().
   void undoMove() {
+    if (lastIsNullMove()) {
+      undoNullMove();
+      return;
+    }
+
     if (historyIsEmpty()) return;
 
     removePositionOccurrence();
@@ -170,6 +248,17 @@ class Game {
 
     popBackHistory();
   }
+  /// @brief Undoes the last move played as undoMove() does, and reports the
+  /// pieces it puts back to the observer. A null move changes no piece, so
+  /// undoing one reports nothing.
+  template <BoardObserver Observer>
+  void undoMove(Observer& observer) {
+    if (!lastIsNullMove() && !historyIsEmpty()) {
+      internal::notifyUndoMove(lastMove(), !activeColor(), observer);
+    }
+
+    undoMove();
+  }
 
   /// @brief Resets the game to the initial position
   void reset() {
@@ -181,11 +270,59 @@ class Game {
     updateRepetitionTracker();
   }
 
+  /// @brief Brings the game to the state reached by playing the given moves
+  /// from the given initial position, as a protocol resending the whole game
+  /// on every move needs.
+  ///
+  /// Only the moves after the longest common prefix with uciMoves() are
+  /// undone and played, so following a game one move at a time costs a
+  /// move per update rather than the whole game. The game is replayed from
+  /// scratch only when the initial position differs. Null moves are undone.
+  /// @return An error if one of the moves is illegal, in which case the game
+  /// is left after the moves before it.
+  auto syncTo(const Position& initial_position, std::span<const UciMove> moves)
+      -> std::expected<void, MoveError> {
+    size_t common = 0;
+    if (initial_position == initial_position_) {
+      common = static_cast<size_t>(
+          std::ranges::mismatch(uci_move_history_, moves).in1 -
+          uci_move_history_.begin());
+      if (!null_move_history_.empty()) {
+        common = std::min(common, null_move_history_.front().ply);
+      }
+    } else {
+      *this = Game(initial_position);
+    }
+
+    while (move_history_.size() > common || !null_move_history_.empty()) {
+      undoMove();
+    }
+
+    for (const auto& move : moves.subspan(common)) {
+      auto result = executeMove(move);
+      if (!result) return result;
+    }
+    return {};
+  }
+
   /// @}
 
  private:
+  // A null move, with the number of moves played before it.
+  struct NullMoveEntry {
+    internal::NullMoveRecord record;
+    size_t ply = 0;
+  };
+
+  // Kept so that telling a default start apart copies no position.
+  static auto defaultPosition() -> const Position& {
+    static const Position kDefaultPosition;
+    return kDefaultPosition;
+  }
+
   template <typename MoveInput>
   auto executeMove(const MoveInput& move) -> std::expected<void, MoveError> {
+    internal::recordStat(&stats::Counters::game_moves);
     auto result = internal::PositionModifier::move(current_position_, move);
 
     if (result) {
@@ -196,6 +333,14 @@ class Game {
 
     return std::unexpected(result.error());
   }
+  template <typename MoveInput, BoardObserver Observer>
+  auto executeMove(const MoveInput& move, Observer& observer)
+      -> std::expected<void, MoveError> {
+    auto result = executeMove(move);
+    if (result) internal::notifyMove(lastMove(), !activeColor(), observer);
+
+    return result;
+  }
 
   auto isGameOver() const -> bool { return isCheckmate() || isDraw(); }
   auto isCheckmate() const -> bool {
@@ -214,11 +359,25 @@ class Game {
     return internal::isInsufficientMaterialDraw(current_position_);
   }
   auto isThreefoldRepetition() const -> bool {
-    return repetition_tracker_.at(current_position_) >= 3;
+    internal::recordStat(&stats::Counters::repetition_probes);
+    if (null_move_history_.empty()) {
+      return repetition_tracker_.at(current_position_) >= 3;
+    }
+
+    auto since_null_move = std::ranges::subrange(
+        std::prev(zobrist_keys_.end(),
+                  static_cast<std::ptrdiff_t>(pliesSinceNullMove()) + 1),
+        zobrist_keys_.end());
+    return std::ranges::count(since_null_move, zobrist_keys_.back()) >= 3;
   }
 
   auto historyIsEmpty() -> bool { return move_history_.empty(); }
+  auto lastIsNullMove() -> bool {
+    return !null_move_history_.empty() &&
+           null_move_history_.back().ply == move_history_.size();
+  }
   void clearHistory() {
+    null_move_history_.clear();
     move_history_.clear();
     uci_move_history_.clear();
     san_move_history_.clear();
@@ -237,22 +396,41 @@ class Game {
     return move_history_.back();
   }
 
-  void clearRepetitionTracker() { repetition_tracker_.clear(); }
+  // The key list follows every position the game enters and leaves. The
+  // repetition tracker skips those reached after a null move, which could
+  // otherwise match positions from before it. Moves are undone in the
+  // reverse order, so a position leaves the tracker only if it entered it.
+  void clearRepetitionTracker() {
+    repetition_tracker_.clear();
+    zobrist_keys_.clear();
+  }
   void removePositionOccurrence() {
+    zobrist_keys_.pop_back();
+    if (!null_move_history_.empty()) return;
+
+    internal::recordStat(&stats::Counters::repetition_probes);
     repetition_tracker_[current_position_]--;
     if (repetition_tracker_[current_position_] == 0) {
       repetition_tracker_.erase(current_position_);
     }
   }
-  void updateRepetitionTracker() { repetition_tracker_[current_position_]++; }
+  void updateRepetitionTracker() {
+    zobrist_keys_.push_back(current_position_.zobristKey());
+    if (!null_move_history_.empty()) return;
+
+    internal::recordStat(&stats::Counters::repetition_probes);
+    repetition_tracker_[current_position_]++;
+  }
 
   Position initial_position_;
   bool is_default_start_ = true;
   Position current_position_;
   std::vector<internal::MoveRecord> move_history_;
+  std::vector<NullMoveEntry> null_move_history_;
   std::vector<UciMove> uci_move_history_;
   std::vector<SanMove> san_move_history_;
   RepetitionTracker repetition_tracker_;
+  std::vector<uint64_t> zobrist_keys_;
 };
 
 }  // namespace chesscxx
@@ -0,0 +1,287 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_BITBOARD_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_BITBOARD_H_
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "../../color.h"
+#include "../../file.h"
+#include "../../piece_type.h"
+#include "../../rank.h"
+#include "../../square.h"
+#include "square.h"
+
+namespace chesscxx::internal {
+
+// One bit per square, using the same indices as index(Square): a8 is bit 0
+// and h1 is bit 63.
+using Bitboard = uint64_t;
+
+inline constexpr size_t kNumColors = 2;
+inline constexpr size_t kNumPieceTypes = 6;
+
+constexpr auto colorIndex(const Color& color) -> size_t {
+  return static_cast<size_t>(color);
+}
+
+constexpr auto pieceTypeIndex(const PieceType& type) -> size_t {
+  return static_cast<size_t>(type);
+}
+
+constexpr auto squareBit(size_t square_index) -> Bitboard {
+  return Bitboard{1} << square_index;
+}
+
+constexpr auto squareBit(const Square& square) -> Bitboard {
+  return squareBit(index(square));
+}
+
+constexpr auto squareFromIndex(size_t square_index) -> Square {
+  auto square = createSquareFromIndex(static_cast<uint8_t>(square_index));
+  if (!square) std::unreachable();
+  return *square;
+}
+
+// All squares on the same file as the given square.
+constexpr auto fileBitboard(size_t square_index) -> Bitboard {
+  constexpr Bitboard kFirstFile = 0x0101010101010101;
+  return kFirstFile << (square_index % kNumFiles);
+}
+
+// All squares on the same rank as the given square.
+constexpr auto rankBitboard(size_t square_index) -> Bitboard {
+  constexpr Bitboard kFirstRank = 0xFF;
+  return kFirstRank << (square_index - (square_index % kNumFiles));
+}
+
+constexpr auto lsbIndex(Bitboard bitboard) -> size_t {
+  return static_cast<size_t>(std::countr_zero(bitboard));
+}
+
+constexpr auto msbIndex(Bitboard bitboard) -> size_t {
+  return static_cast<size_t>(63 - std::countl_zero(bitboard));
+}
+
+constexpr auto popLsb(Bitboard& bitboard) -> size_t {
+  auto square_index = lsbIndex(bitboard);
+  bitboard &= bitboard - 1;
+  return square_index;
+}
+
+constexpr auto isSingleBit(Bitboard bitboard) -> bool {
+  return std::has_single_bit(bitboard);
+}
+
+using AttackTable = std::array<Bitboard, kNumSquares>;
+
+constexpr auto shiftedBit(size_t square_index, const SquareOffset& offset)
+    -> Bitboard {
+  auto shifted = shiftSquare(squareFromIndex(square_index), offset);
+  return shifted ? squareBit(*shifted) : Bitboard{0};
+}
+
+template <size_t N>
+constexpr auto leaperAttacks(const std::array<SquareOffset, N>& offsets)
+    -> AttackTable {
+  AttackTable table{};
+  for (size_t square_index = 0; square_index < kNumSquares; ++square_index) {
+    for (const auto& offset : offsets) {
+      table.at(square_index) |= shiftedBit(square_index, offset);
+    }
+  }
+  return table;
+}
+
+inline constexpr AttackTable kKnightAttacks = leaperAttacks<8>(
+    {{{.file_offset = 2, .rank_offset = 1},
+      {.file_offset = 2, .rank_offset = -1},
+      {.file_offset = 1, .rank_offset = 2},
+      {.file_offset = 1, .rank_offset = -2},
+      {.file_offset = -1, .rank_offset = 2},
+      {.file_offset = -1, .rank_offset = -2},
+      {.file_offset = -2, .rank_offset = 1},
+      {.file_offset = -2, .rank_offset = -1}}});
+
+inline constexpr AttackTable kKingAttacks = leaperAttacks<8>(
+    {{{.file_offset = 1, .rank_offset = 1},
+      {.file_offset = 1, .rank_offset = 0},
+      {.file_offset = 1, .rank_offset = -1},
+      {.file_offset = 0, .rank_offset = 1},
+      {.file_offset = 0, .rank_offset = -1},
+      {.file_offset = -1, .rank_offset = 1},
+      {.file_offset = -1, .rank_offset = 0},
+      {.file_offset = -1, .rank_offset = -1}}});
+
+// Squares attacked by a pawn of the given color. Rank indices grow towards
+// rank 1, so white pawns attack towards negative rank offsets.
+inline constexpr std::array<AttackTable, kNumColors> kPawnAttacks = {
+    leaperAttacks<2>({{{.file_offset = 1, .rank_offset = -1},
+                       {.file_offset = -1, .rank_offset = -1}}}),
+    leaperAttacks<2>({{{.file_offset = 1, .rank_offset = 1},
+                       {.file_offset = -1, .rank_offset = 1}}})};
+
+// Opposite directions are adjacent, so that flipping the lowest bit of a
+// direction gives its opposite.
+enum class RayDirection : uint8_t {
+  kNorth,
+  kSouth,
+  kEast,
+  kWest,
+  kNorthEast,
+  kSouthWest,
+  kNorthWest,
+  kSouthEast,
+};
+
+inline constexpr size_t kNumRayDirections = 8;
+
+inline constexpr std::array<SquareOffset, kNumRayDirections> kRayOffsets = {
+    {{.file_offset = 0, .rank_offset = -1},
+     {.file_offset = 0, .rank_offset = 1},
+     {.file_offset = 1, .rank_offset = 0},
+     {.file_offset = -1, .rank_offset = 0},
+     {.file_offset = 1, .rank_offset = -1},
+     {.file_offset = -1, .rank_offset = 1},
+     {.file_offset = -1, .rank_offset = -1},
+     {.file_offset = 1, .rank_offset = 1}}};
+
+// Whether square indices grow along the direction, which decides whether the
+// nearest blocker is the least or the most significant bit.
+constexpr auto isIncreasing(const RayDirection& direction) -> bool {
+  const auto& offset = kRayOffsets.at(static_cast<size_t>(direction));
+  return (offset.rank_offset * static_cast<int>(kNumFiles)) +
+             offset.file_offset >
+         0;
+}
+
+// Squares from the given square to the edge of the board, excluding the square
+// itself.
+inline constexpr auto kRays = [] {
+  std::array<AttackTable, kNumRayDirections> rays{};
+  for (size_t direction = 0; direction < kNumRayDirections; ++direction) {
+    for (size_t square_index = 0; square_index < kNumSquares; ++square_index) {
+      auto square = shiftSquare(squareFromIndex(square_index),
+                                kRayOffsets.at(direction));
+      while (square) {
+        rays.at(direction).at(square_index) |= squareBit(*square);
+        square = shiftSquare(*square, kRayOffsets.at(direction));
+      }
+    }
+  }
+  return rays;
+}();
+
+constexpr auto ray(const RayDirection& direction, size_t square_index)
+    -> Bitboard {
+  return kRays.at(static_cast<size_t>(direction)).at(square_index);
+}
+
+constexpr auto rayAttacks(const RayDirection& direction, size_t square_index,
+                          Bitboard occupancy) -> Bitboard {
+  auto attacks = ray(direction, square_index);
+  auto blockers = attacks & occupancy;
+  if (blockers == 0) return attacks;
+
+  auto blocker = isIncreasing(direction) ? lsbIndex(blockers)
+                                         : msbIndex(blockers);
+  return attacks ^ ray(direction, blocker);
+}
+
+constexpr auto rookAttacks(size_t square_index, Bitboard occupancy)
+    -> Bitboard {
+  return rayAttacks(RayDirection::kNorth, square_index, occupancy) |
+         rayAttacks(RayDirection::kSouth, square_index, occupancy) |
+         rayAttacks(RayDirection::kEast, square_index, occupancy) |
+         rayAttacks(RayDirection::kWest, square_index, occupancy);
+}
+
+constexpr auto bishopAttacks(size_t square_index, Bitboard occupancy)
+    -> Bitboard {
+  return rayAttacks(RayDirection::kNorthEast, square_index, occupancy) |
+         rayAttacks(RayDirection::kNorthWest, square_index, occupancy) |
+         rayAttacks(RayDirection::kSouthEast, square_index, occupancy) |
+         rayAttacks(RayDirection::kSouthWest, square_index, occupancy);
+}
+
+constexpr auto knightAttacks(size_t square_index) -> Bitboard {
+  return kKnightAttacks.at(square_index);
+}
+
+constexpr auto kingAttacks(size_t square_index) -> Bitboard {
+  return kKingAttacks.at(square_index);
+}
+
+constexpr auto pawnAttacks(const Color& color, size_t square_index)
+    -> Bitboard {
+  return kPawnAttacks.at(colorIndex(color)).at(square_index);
+}
+
+// Attacks of a knight, bishop, rook, queen or king.
+constexpr auto pieceAttacks(const PieceType& type, size_t square_index,
+                            Bitboard occupancy) -> Bitboard {
+  switch (type) {
+    case PieceType::kKnight:
+      return knightAttacks(square_index);
+    case PieceType::kBishop:
+      return bishopAttacks(square_index, occupancy);
+    case PieceType::kRook:
+      return rookAttacks(square_index, occupancy);
+    case PieceType::kQueen:
+      return bishopAttacks(square_index, occupancy) |
+             rookAttacks(square_index, occupancy);
+    case PieceType::kKing:
+      return kingAttacks(square_index);
+    default:
+      return 0;
+  }
+}
+
+using SquarePairTable = std::array<AttackTable, kNumSquares>;
+
+// For two squares on a common rank, file or diagonal, the squares strictly
+// between them. Empty otherwise.
+inline constexpr auto kBetween = [] {
+  SquarePairTable between{};
+  for (size_t direction = 0; direction < kNumRayDirections; ++direction) {
+    for (size_t from = 0; from < kNumSquares; ++from) {
+      auto targets = kRays.at(direction).at(from);
+      while (targets != 0) {
+        auto to = popLsb(targets);
+        between.at(from).at(to) = kRays.at(direction).at(from) &
+                                  ~kRays.at(direction).at(to) & ~squareBit(to);
+      }
+    }
+  }
+  return between;
+}();
+
+// For two squares on a common rank, file or diagonal, the whole line through
+// them, edge to edge. Empty otherwise.
+inline constexpr auto kLines = [] {
+  SquarePairTable lines{};
+  for (size_t direction = 0; direction < kNumRayDirections; ++direction) {
+    auto opposite = direction ^ 1U;
+    for (size_t from = 0; from < kNumSquares; ++from) {
+      auto line = kRays.at(direction).at(from) |
+                  kRays.at(opposite).at(from) | squareBit(from);
+      auto targets = kRays.at(direction).at(from);
+      while (targets != 0) lines.at(from).at(popLsb(targets)) = line;
+    }
+  }
+  return lines;
+}();
+
+constexpr auto squaresBetween(size_t from, size_t to) -> Bitboard {
+  return kBetween.at(from).at(to);
+}
+
+constexpr auto lineThrough(size_t from, size_t to) -> Bitboard {
+  return kLines.at(from).at(to);
+}
+
+}  // namespace chesscxx::internal
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_BITBOARD_H_
@@ -0,0 +1,109 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_BOARD_OBSERVER_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_BOARD_OBSERVER_H_
+
+#include <variant>
+
+#include "../../board_observer.h"
+#include "../../color.h"
+#include "../../piece.h"
+#include "../../piece_type.h"
+#include "castling_rules.h"
+#include "move_record.h"
+#include "square.h"
+
+namespace chesscxx::internal {
+
+// The piece changes of a move are told apart from its record, after the move
+// is made, so a move made without an observer does no extra work.
+template <BoardObserver Observer>
+void notifyMove(const NormalMoveRecord& move, const Color& mover,
+                Observer& observer) {
+  const auto& uci = move.uci_move;
+  auto piece = Piece(move.piece_type, mover);
+
+  if (move.captured_piece_type) {
+    observer.onRemove(Piece(*move.captured_piece_type, !mover),
+                      uci.destination);
+  }
+
+  if (move.is_en_passant_capture) {
+    if (auto captured_pawn_square =
+            enPassantCapturedPawnSquare(uci.destination, mover)) {
+      observer.onRemove(Piece(PieceType::kPawn, !mover), *captured_pawn_square);
+    }
+  }
+
+  if (uci.promotion) {
+    observer.onRemove(piece, uci.origin);
+    observer.onAdd(Piece(toPieceType(*uci.promotion), mover), uci.destination);
+    return;
+  }
+
+  observer.onMove(piece, uci.origin, uci.destination);
+}
+
+template <BoardObserver Observer>
+void notifyMove(const CastlingMoveRecord& move, const Color& /*mover*/,
+                Observer& observer) {
+  auto moves = castlingMoves(move.side, move.color);
+
+  observer.onMove(Piece(PieceType::kKing, move.color),
+                  moves.king_move.origin, moves.king_move.destination);
+  observer.onMove(Piece(PieceType::kRook, move.color),
+                  moves.rook_move.origin, moves.rook_move.destination);
+}
+
+template <BoardObserver Observer>
+void notifyMove(const MoveRecord& move, const Color& mover,
+                Observer& observer) {
+  std::visit([&](const auto& arg) { notifyMove(arg, mover, observer); }, move);
+}
+
+// The changes of notifyMove() reversed, in reverse order.
+template <BoardObserver Observer>
+void notifyUndoMove(const NormalMoveRecord& move, const Color& mover,
+                    Observer& observer) {
+  const auto& uci = move.uci_move;
+  auto piece = Piece(move.piece_type, mover);
+
+  if (uci.promotion) {
+    observer.onRemove(Piece(toPieceType(*uci.promotion), mover),
+                      uci.destination);
+    observer.onAdd(piece, uci.origin);
+  } else {
+    observer.onMove(piece, uci.destination, uci.origin);
+  }
+
+  if (move.is_en_passant_capture) {
+    if (auto captured_pawn_square =
+            enPassantCapturedPawnSquare(uci.destination, mover)) {
+      observer.onAdd(Piece(PieceType::kPawn, !mover), *captured_pawn_square);
+    }
+  }
+
+  if (move.captured_piece_type) {
+    observer.onAdd(Piece(*move.captured_piece_type, !mover), uci.destination);
+  }
+}
+
+template <BoardObserver Observer>
+void notifyUndoMove(const CastlingMoveRecord& move, const Color& /*mover*/,
+                    Observer& observer) {
+  auto moves = castlingMoves(move.side, move.color);
+
+  observer.onMove(Piece(PieceType::kRook, move.color),
+                  moves.rook_move.destination, moves.rook_move.origin);
+  observer.onMove(Piece(PieceType::kKing, move.color),
+                  moves.king_move.destination, moves.king_move.origin);
+}
+
+template <BoardObserver Observer>
+void notifyUndoMove(const MoveRecord& move, const Color& mover,
+                    Observer& observer) {
+  std::visit([&](const auto& arg) { notifyUndoMove(arg, mover, observer); },
+             move);
+}
+
+}  // namespace chesscxx::internal
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_BOARD_OBSERVER_H_
@@ -0,0 +1,97 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_CUCKOO_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_CUCKOO_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "../../color.h"
+#include "../../piece_type.h"
+#include "bitboard.h"
+#include "zobrist.h"
+
+namespace chesscxx::internal {
+
+// A move of a piece between two squares, in either direction.
+struct CuckooMove {
+  uint8_t first_square = 0;
+  uint8_t second_square = 0;
+};
+
+inline constexpr size_t kCuckooSize = 8192;
+
+constexpr auto cuckooHash1(ZobristKey key) -> size_t {
+  return key & (kCuckooSize - 1);
+}
+
+constexpr auto cuckooHash2(ZobristKey key) -> size_t {
+  return (key >> 16U) & (kCuckooSize - 1);
+}
+
+// Every move of a knight, bishop, rook, queen or king on an empty board,
+// keyed by the change it makes to the Zobrist key of a position: its piece
+// keys on both squares and the side key. Such moves are the only ones a
+// position can be undone by, so two positions a move apart whose keys
+// differ by one of these keys differ by that move. Each key sits at one of
+// its two hashes, which cuckoo hashing keeps collision-free.
+struct CuckooTable {
+  std::array<ZobristKey, kCuckooSize> keys{};
+  std::array<CuckooMove, kCuckooSize> moves{};
+  size_t size = 0;
+};
+
+constexpr auto makeCuckooTable() -> CuckooTable {
+  CuckooTable table;
+  for (auto color : {Color::kWhite, Color::kBlack}) {
+    for (auto type : {PieceType::kKnight, PieceType::kBishop, PieceType::kRook,
+                      PieceType::kQueen, PieceType::kKing}) {
+      const auto& piece_keys =
+          kZobristKeys.pieces.at(colorIndex(color)).at(pieceTypeIndex(type));
+      for (size_t first = 0; first < kNumSquares; ++first) {
+        for (auto targets = pieceAttacks(type, first, 0); targets != 0;) {
+          auto second = popLsb(targets);
+          if (second < first) continue;  // Added from the other square.
+
+          auto key = piece_keys.at(first) ^ piece_keys.at(second) ^
+                     kZobristKeys.black_to_move;
+          CuckooMove move{.first_square = static_cast<uint8_t>(first),
+                          .second_square = static_cast<uint8_t>(second)};
+
+          // Evicts whatever holds the slot to its other slot, until a free
+          // slot is found.
+          auto slot = cuckooHash1(key);
+          while (true) {
+            std::swap(table.keys.at(slot), key);
+            std::swap(table.moves.at(slot), move);
+            if (key == 0) break;
+            slot = slot == cuckooHash1(key) ? cuckooHash2(key)
+                                            : cuckooHash1(key);
+          }
+          ++table.size;
+        }
+      }
+    }
+  }
+  return table;
+}
+
+inline constexpr CuckooTable kCuckooTable = makeCuckooTable();
+static_assert(kCuckooTable.size == 3668,
+              "every reversible move must find a slot in the table");
+
+// The move changing a position's key by the given difference, if any.
+constexpr auto findCuckooMove(ZobristKey key_difference)
+    -> std::optional<CuckooMove> {
+  for (auto slot : {cuckooHash1(key_difference), cuckooHash2(key_difference)}) {
+    if (kCuckooTable.keys.at(slot) == key_difference) {
+      return kCuckooTable.moves.at(slot);
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace chesscxx::internal
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_CUCKOO_H_
@@ -40,6 +40,12 @@ struct NormalMoveRecord {
 
 using MoveRecord = std::variant<NormalMoveRecord, CastlingMoveRecord>;
 
+// A null move only passes the turn, so only the state it clears is kept.
+struct NullMoveRecord {
+  std::optional<File> previous_en_passant_file = std::nullopt;
+  uint32_t previous_halfmove_clock{};
+};
+
 template <typename MoveOutput>
 struct Converter;
 
@@ -7,31 +7,28 @@
 
 #include "../../castling_side.h"
 #include "../../color.h"
+#include "../../file.h"
 #include "../../move_error.h"
 #include "../../movegen/internal/piece_placement_movegen.h"
-#include "../../movegen/internal/square_movegen.h"
 #include "../../piece.h"
 #include "../../piece_placement.h"
 #include "../../piece_type.h"
 #include "../../rank.h"
 #include "../../square.h"
+#include "../../stats.h"
 #include "../../uci_move.h"
+#include "bitboard.h"
 #include "castling_rules.h"
+#include "file.h"
+#include "piece_placement_bitboards.h"
 #include "piece_placement_piece_at.h"
 #include "rank.h"
 #include "raw_move.h"
+#include "square.h"
 #include "uci_move.h"
 
 namespace chesscxx::internal {
 
-inline auto moveResultsInSelfCheck(PiecePlacement /*piece_placement*/,
-                                   const RawMove& /*move*/,
-                                   const Color& /*color*/) -> bool;
-
-inline auto enPassantCaptureResultsInSelfCheck(
-    PiecePlacement /*piece_placement*/, const RawMove& /*move*/,
-    const Square& /*captured_pawn_square*/, const Color& /*color*/) -> bool;
-
 inline auto castlingError(PiecePlacement /*piece_placement*/,
                           const CastlingSide& /*side*/, const Color& /*color*/)
     -> std::optional<MoveError>;
@@ -39,8 +36,12 @@ inline auto castlingError(PiecePlacement /*piece_placement*/,
 inline auto isAttacked(const PiecePlacement& piece_placement,
                        const Square& square, const Color& attacker_color)
     -> bool {
-  auto pieces = piecesAttacking(piece_placement, square, attacker_color);
-  return pieces.begin() != pieces.end();
+  using Bitboards = PiecePlacementBitboards;
+
+  recordStat(&stats::Counters::attack_queries);
+  return (attackersTo(piece_placement, index(square),
+                      Bitboards::occupancy(piece_placement)) &
+          Bitboards::pieces(piece_placement, attacker_color)) != 0;
 }
 
 inline auto kingLocation(const PiecePlacement& piece_placement,
@@ -57,20 +58,95 @@ inline auto isKingAttacked(const PiecePlacement& piece_placement,
                     !color);
 }
 
+// Whether the predicate holds on any square a castling move passes over, its
+// origin and destination included. Castling moves stay on their rank, so the
+// squares are walked in place rather than through a generator, whose frame
+// would not come from the caller's allocator.
+template <typename Predicate>
+inline auto anyTraversedSquare(const RawMove& move, Predicate predicate)
+    -> bool {
+  auto [first, last] =
+      std::minmax({index(move.origin.file), index(move.destination.file)});
+  for (auto file = first; file <= last; ++file) {
+    if (predicate(Square{.file = static_cast<File>(file),
+                         .rank = move.origin.rank})) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Opponent pieces attacking the king of the given color once the move is made
+// and the pieces on `cleared` are removed. Nothing is moved: the move only
+// changes the occupancy seen by sliders, and captured pieces stop attacking.
+inline auto kingAttackersAfter(const PiecePlacement& piece_placement,
+                               const RawMove& move, Bitboard cleared,
+                               const Color& color) -> Bitboard {
+  using Bitboards = PiecePlacementBitboards;
+
+  recordStat(&stats::Counters::attack_queries);
+  auto origin = squareBit(move.origin);
+  auto destination = squareBit(move.destination);
+  auto king = Bitboards::pieces(piece_placement, color, PieceType::kKing);
+  if ((king & origin) != 0) king = destination;
+
+  auto occupancy =
+      (Bitboards::occupancy(piece_placement) & ~origin & ~cleared) |
+      destination;
+
+  return attackersTo(piece_placement, lsbIndex(king), occupancy) &
+         Bitboards::pieces(piece_placement, !color) & ~destination & ~cleared;
+}
+
+inline auto moveResultsInSelfCheck(const PiecePlacement& piece_placement,
+                                   const RawMove& move, const Color& color)
+    -> bool {
+  recordStat(&stats::Counters::self_check_tests);
+  return kingAttackersAfter(piece_placement, move, 0, color) != 0;
+}
+
+inline auto enPassantCaptureResultsInSelfCheck(
+    const PiecePlacement& piece_placement, const RawMove& move,
+    const Square& captured_pawn_square, const Color& color) -> bool {
+  recordStat(&stats::Counters::self_check_tests);
+  return kingAttackersAfter(piece_placement, move,
+                            squareBit(captured_pawn_square), color) != 0;
+}
+
+// Whether a pawn of the given color can capture en passant on the target
+// square without leaving its king in check.
+inline auto hasLegalEnPassantCapture(const PiecePlacement& piece_placement,
+                                     const Square& target, const Color& color)
+    -> bool {
+  using Bitboards = PiecePlacementBitboards;
+
+  auto captured_pawn_square = enPassantCapturedPawnSquare(target, color);
+  if (!captured_pawn_square) return false;
+
+  for (auto pawns = pawnAttacks(!color, index(target)) &
+                    Bitboards::pieces(piece_placement, color, PieceType::kPawn);
+       pawns != 0;) {
+    RawMove const move(squareFromIndex(popLsb(pawns)), target);
+    if (!enPassantCaptureResultsInSelfCheck(piece_placement, move,
+                                            *captured_pawn_square, color)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 inline auto isMoveClear(const PiecePlacement& piece_placement,
                         const RawMove& move) -> bool {
-  return std::ranges::none_of(traversedSquares(move.origin, move.destination),
-                              [piece_placement](const auto& square) {
-                                return hasPieceAt(piece_placement, square);
-                              });
+  return !anyTraversedSquare(move, [&piece_placement](const Square& square) {
+    return hasPieceAt(piece_placement, square);
+  });
 }
 
 inline auto isMoveUnderAttack(const PiecePlacement& piece_placement,
                               const RawMove& move, const Color& attacker_color)
     -> bool {
-  return std::ranges::any_of(
-      traversedSquares(move.origin, move.destination),
-      [piece_placement, attacker_color](const auto& square) {
+  return anyTraversedSquare(
+      move, [&piece_placement, &attacker_color](const Square& square) {
         return isAttacked(piece_placement, square, attacker_color);
       });
 }
@@ -234,22 +310,6 @@ class PiecePlacementModifier {
   }
 };
 
-inline auto moveResultsInSelfCheck(PiecePlacement piece_placement,
-                                   const RawMove& move, const Color& color)
-    -> bool {
-  PiecePlacementModifier::relocatePiece(piece_placement, move);
-  return isKingAttacked(piece_placement, color);
-}
-
-inline auto enPassantCaptureResultsInSelfCheck(
-    PiecePlacement piece_placement, const RawMove& move,
-    const Square& captured_pawn_square, const Color& color) -> bool {
-  PiecePlacementModifier::relocatePiece(piece_placement, move);
-  PiecePlacementModifier::setPieceAt(piece_placement, captured_pawn_square,
-                                     std::nullopt);
-  return isKingAttacked(piece_placement, color);
-}
-
 inline auto castlingError(PiecePlacement piece_placement,
                           const CastlingSide& side, const Color& color)
     -> std::optional<MoveError> {
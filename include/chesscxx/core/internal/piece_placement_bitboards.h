@@ -0,0 +1,115 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_PIECE_PLACEMENT_BITBOARDS_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_PIECE_PLACEMENT_BITBOARDS_H_
+
+#include <cstddef>
+
+#include "../../color.h"
+#include "../../piece_placement.h"
+#include "../../piece_type.h"
+#include "bitboard.h"
+#include "zobrist.h"
+
+namespace chesscxx::internal {
+
+class PiecePlacementBitboards {
+ public:
+  static constexpr auto occupancy(const PiecePlacement& piece_placement)
+      -> Bitboard {
+    return piece_placement.color_bitboards_.at(colorIndex(Color::kWhite)) |
+           piece_placement.color_bitboards_.at(colorIndex(Color::kBlack));
+  }
+
+  static constexpr auto pieces(const PiecePlacement& piece_placement,
+                               const Color& color) -> Bitboard {
+    return piece_placement.color_bitboards_.at(colorIndex(color));
+  }
+
+  static constexpr auto pieces(const PiecePlacement& piece_placement,
+                               const PieceType& type) -> Bitboard {
+    return piece_placement.type_bitboards_.at(pieceTypeIndex(type));
+  }
+
+  static constexpr auto pieces(const PiecePlacement& piece_placement,
+                               const Color& color, const PieceType& type)
+      -> Bitboard {
+    return pieces(piece_placement, color) & pieces(piece_placement, type);
+  }
+
+  // Zobrist key of the pieces alone, updated with every piece change.
+  static constexpr auto zobristKey(const PiecePlacement& piece_placement)
+      -> ZobristKey {
+    return piece_placement.zobrist_key_;
+  }
+
+  // Zobrist key of the pawns alone, updated only when a pawn is placed or
+  // removed.
+  static constexpr auto pawnKey(const PiecePlacement& piece_placement)
+      -> ZobristKey {
+    return piece_placement.pawn_key_;
+  }
+};
+
+// Pieces of both colors attacking the given square when only the squares in
+// occupancy block sliders. Clearing a slider from occupancy reveals the
+// pieces behind it.
+constexpr auto attackersTo(const PiecePlacement& piece_placement,
+                           size_t square_index, Bitboard occupancy)
+    -> Bitboard {
+  using Bitboards = PiecePlacementBitboards;
+
+  auto queens = Bitboards::pieces(piece_placement, PieceType::kQueen);
+  auto diagonal_sliders =
+      Bitboards::pieces(piece_placement, PieceType::kBishop) | queens;
+  auto straight_sliders =
+      Bitboards::pieces(piece_placement, PieceType::kRook) | queens;
+
+  return (pawnAttacks(Color::kBlack, square_index) &
+          Bitboards::pieces(piece_placement, Color::kWhite,
+                            PieceType::kPawn)) |
+         (pawnAttacks(Color::kWhite, square_index) &
+          Bitboards::pieces(piece_placement, Color::kBlack,
+                            PieceType::kPawn)) |
+         (knightAttacks(square_index) &
+          Bitboards::pieces(piece_placement, PieceType::kKnight)) |
+         (kingAttacks(square_index) &
+          Bitboards::pieces(piece_placement, PieceType::kKing)) |
+         (bishopAttacks(square_index, occupancy) & diagonal_sliders) |
+         (rookAttacks(square_index, occupancy) & straight_sliders);
+}
+
+// Sliders of the given color attacking the square through the occupancy.
+constexpr auto sliderAttackersTo(const PiecePlacement& piece_placement,
+                                 size_t square_index, Bitboard occupancy,
+                                 const Color& color) -> Bitboard {
+  using Bitboards = PiecePlacementBitboards;
+
+  auto queens = Bitboards::pieces(piece_placement, color, PieceType::kQueen);
+  return (bishopAttacks(square_index, occupancy) &
+          (Bitboards::pieces(piece_placement, color, PieceType::kBishop) |
+           queens)) |
+         (rookAttacks(square_index, occupancy) &
+          (Bitboards::pieces(piece_placement, color, PieceType::kRook) |
+           queens));
+}
+
+// Pieces of either color standing alone between the square and a slider of
+// the given color aimed at it. With a king on the square, these are its
+// pinned pieces or the candidates for a discovered check.
+constexpr auto sliderBlockers(const PiecePlacement& piece_placement,
+                              size_t square_index, const Color& slider_color)
+    -> Bitboard {
+  auto occupancy = PiecePlacementBitboards::occupancy(piece_placement);
+  auto snipers =
+      sliderAttackersTo(piece_placement, square_index, 0, slider_color);
+
+  Bitboard blockers = 0;
+  while (snipers != 0) {
+    auto between = squaresBetween(square_index, popLsb(snipers)) & occupancy;
+    if (isSingleBit(between)) blockers |= between;
+  }
+  return blockers;
+}
+
+}  // namespace chesscxx::internal
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_PIECE_PLACEMENT_BITBOARDS_H_
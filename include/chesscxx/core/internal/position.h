@@ -1,26 +1,22 @@
 #ifndef CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_POSITION_H_
 #define CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_POSITION_H_
 
-#include <algorithm>
-#include <cstdint>
 #include <expected>
 #include <optional>
-#include <unordered_map>
 
 #include "../../color.h"
-#include "../../file.h"
 #include "../../move_error.h"
 #include "../../movegen/internal/position_movegen.h"
 #include "../../piece_type.h"
 #include "../../position.h"
-#include "../../rank.h"
 #include "../../san_move.h"
 #include "../../square.h"
 #include "../../uci_move.h"
-#include "partial_square.h"
+#include "bitboard.h"
 #include "piece_placement.h"
 #include "piece_placement_material.h"
 #include "piece_placement_piece_at.h"
+#include "position_origins.h"
 #include "raw_move.h"
 
 namespace chesscxx::internal {
@@ -51,30 +47,31 @@ constexpr auto isGameOver(const Position& position) -> bool {
   return isCheckmate(position) || isDraw(position);
 }
 
+// A SAN origin only has to single out the moving piece among the pieces that
+// can legally make the move. A single candidate is returned even when pinned,
+// so that the move is later rejected as leaving the king in check.
 inline auto uciFromSan(const Position& position, const SanNormalMove& san_move,
                        const Color& color)
     -> std::expected<UciMove, MoveError> {
-  auto piece_type = san_move.piece_type;
   auto destination = san_move.destination;
 
-  auto possible_origins = piecesReaching(position, destination,
-                                         {.type = piece_type, .color = color});
-  auto partial_origin = san_move.origin;
-  std::optional<Square> origin;
+  auto candidates =
+      originCandidates(position, destination,
+                       {.type = san_move.piece_type, .color = color}) &
+      partialSquareBitboard(san_move.origin);
 
-  for (const Square& square : possible_origins) {
-    if (!matches(partial_origin, square)) continue;
+  if (candidates == 0) return std::unexpected(MoveError::kNoValidOrigin);
 
-    if (!origin) {
-      origin = square;
-    } else {
+  if (!isSingleBit(candidates)) {
+    candidates = unpinnedOrigins(position.piecePlacement(), candidates,
+                                 destination, color);
+    if (!isSingleBit(candidates)) {
       return std::unexpected(MoveError::kAmbiguousOrigin);
     }
   }
 
-  if (!origin) return std::unexpected(MoveError::kNoValidOrigin);
-
-  return UciMove(*origin, destination, san_move.promotion);
+  return UciMove(squareFromIndex(lsbIndex(candidates)), destination,
+                 san_move.promotion);
 }
 
 inline auto partialOriginFromMove(const Position& position, const RawMove& move)
@@ -93,43 +90,23 @@ inline auto partialOriginFromMove(const Position& position, const RawMove& move)
     return PartialSquare(origin.file, std::nullopt);
   }
 
-  auto possible_origins = piecesReaching(position, destination, *piece);
-
-  std::unordered_map<File, uint8_t> file_counter;
-  std::unordered_map<Rank, uint8_t> rank_counter;
-
-  int total = 0;
-  for (const Square& square : possible_origins) {
-    file_counter[square.file]++;
-    rank_counter[square.rank]++;
-    total++;
-  }
-
-  if (total == 0) return std::unexpected(MoveError::kNoValidOrigin);
-  if (total == 1) return PartialSquare{};
-
-  if (file_counter[origin.file] == 1) {
-    return PartialSquare(origin.file, std::nullopt);
-  }
+  auto candidates = originCandidates(position, destination, *piece);
+  if (candidates == 0) return std::unexpected(MoveError::kNoValidOrigin);
 
-  if (rank_counter[origin.rank] == 1) {
-    return PartialSquare(std::nullopt, origin.rank);
-  }
+  candidates = unpinnedOrigins(position.piecePlacement(), candidates,
+                               destination, piece->color) |
+               squareBit(origin);
 
-  return PartialSquare(origin.file, origin.rank);
+  return disambiguatingOrigin(candidates, origin);
 }
 
 inline auto uciMoveError(const Position& position, const RawMove& move)
     -> std::optional<MoveError> {
-  const auto& origin = move.origin;
-  const auto& destination = move.destination;
-
-  auto piece = pieceAt(position.piecePlacement(), origin);
+  auto piece = pieceAt(position.piecePlacement(), move.origin);
   if (!piece) return MoveError::kNoPieceAtOrigin;
 
-  auto possible_origins = piecesReaching(position, destination, *piece);
-
-  if (std::ranges::find(possible_origins, origin) == possible_origins.end()) {
+  if ((originCandidates(position, move.destination, *piece) &
+       squareBit(move.origin)) == 0) {
     return MoveError::kIllegalMove;
   }
 
@@ -0,0 +1,136 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_POSITION_CHECK_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_POSITION_CHECK_H_
+
+#include <array>
+#include <cstddef>
+
+#include "../../castling_side.h"
+#include "../../color.h"
+#include "../../piece_type.h"
+#include "../../position.h"
+#include "../../square.h"
+#include "../../uci_move.h"
+#include "bitboard.h"
+#include "castling_rules.h"
+#include "piece_placement.h"
+#include "piece_placement_bitboards.h"
+#include "piece_placement_piece_at.h"
+#include "square.h"
+
+namespace chesscxx::internal {
+
+// What the side to move needs to know about the opponent king to tell whether
+// a move gives check. Computed once per position and shared by all its moves.
+struct CheckInfo {
+  size_t king = 0;
+  // Squares from which a piece of each type would attack the king.
+  std::array<Bitboard, kNumPieceTypes> check_squares{};
+  // Pieces of the side to move that are the only piece between one of its
+  // sliders and the king. Moving one off that line gives a discovered check.
+  Bitboard discovered_check_candidates = 0;
+};
+
+inline auto checkInfo(const Position& position) -> CheckInfo {
+  using Bitboards = PiecePlacementBitboards;
+
+  const auto& piece_placement = position.piecePlacement();
+  auto us = position.activeColor();
+  auto occupancy = Bitboards::occupancy(piece_placement);
+
+  CheckInfo info;
+  info.king =
+      lsbIndex(Bitboards::pieces(piece_placement, !us, PieceType::kKing));
+
+  auto& check_squares = info.check_squares;
+  check_squares.at(pieceTypeIndex(PieceType::kPawn)) =
+      pawnAttacks(!us, info.king);
+  for (auto type : {PieceType::kKnight, PieceType::kBishop, PieceType::kRook,
+                    PieceType::kQueen}) {
+    check_squares.at(pieceTypeIndex(type)) =
+        pieceAttacks(type, info.king, occupancy);
+  }
+
+  info.discovered_check_candidates =
+      sliderBlockers(piece_placement, info.king, us) &
+      Bitboards::pieces(piece_placement, us);
+
+  return info;
+}
+
+inline auto castlingGivesCheck(const Position& position, const CheckInfo& info,
+                               const CastlingSide& side) -> bool {
+  using Bitboards = PiecePlacementBitboards;
+
+  const auto& piece_placement = position.piecePlacement();
+  auto us = position.activeColor();
+  auto moves = castlingMoves(side, us);
+
+  auto rook = squareBit(moves.rook_move.origin) |
+              squareBit(moves.rook_move.destination);
+  auto occupancy = Bitboards::occupancy(piece_placement) ^ rook ^
+                   squareBit(moves.king_move.origin) ^
+                   squareBit(moves.king_move.destination);
+
+  return (rookAttacks(index(moves.rook_move.destination), occupancy) &
+          squareBit(info.king)) != 0;
+}
+
+// Whether the move, assumed to be legal, checks the opponent king. Nothing is
+// moved: direct checks are looked up in the check squares, and discovered
+// checks come from the pieces that block a slider aimed at the king.
+inline auto givesCheck(const Position& position, const CheckInfo& info,
+                       const UciMove& move) -> bool {
+  const auto& piece_placement = position.piecePlacement();
+  auto us = position.activeColor();
+  auto piece = pieceAt(piece_placement, move.origin);
+  if (!piece) return false;
+
+  if (auto side = castlingSideFromUci(piece_placement, move, us)) {
+    return castlingGivesCheck(position, info, *side);
+  }
+
+  auto origin = index(move.origin);
+  auto destination = index(move.destination);
+  auto destination_bit = squareBit(destination);
+
+  if ((info.check_squares.at(pieceTypeIndex(piece->type)) & destination_bit) !=
+      0) {
+    return true;
+  }
+
+  if ((info.discovered_check_candidates & squareBit(origin)) != 0 &&
+      (lineThrough(origin, info.king) & destination_bit) == 0) {
+    return true;
+  }
+
+  if (piece->type != PieceType::kPawn) return false;
+
+  auto occupancy = PiecePlacementBitboards::occupancy(piece_placement);
+  occupancy = (occupancy ^ squareBit(origin)) | destination_bit;
+
+  if (move.promotion) {
+    return (pieceAttacks(toPieceType(*move.promotion), destination,
+                         occupancy) &
+            squareBit(info.king)) != 0;
+  }
+
+  // An en passant capture also clears the captured pawn's square, which can
+  // uncover a slider on a rank or a diagonal.
+  if (move.destination == position.enPassantTargetSquare()) {
+    if (auto captured_pawn_square =
+            enPassantCapturedPawnSquare(move.destination, us)) {
+      occupancy ^= squareBit(*captured_pawn_square);
+      return sliderAttackersTo(piece_placement, info.king, occupancy, us) != 0;
+    }
+  }
+
+  return false;
+}
+
+inline auto givesCheck(const Position& position, const UciMove& move) -> bool {
+  return givesCheck(position, checkInfo(position), move);
+}
+
+}  // namespace chesscxx::internal
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_POSITION_CHECK_H_
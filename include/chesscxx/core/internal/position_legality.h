@@ -0,0 +1,257 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_POSITION_LEGALITY_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_POSITION_LEGALITY_H_
+
+#include <cstddef>
+
+#include "../../castling_side.h"
+#include "../../color.h"
+#include "../../piece_type.h"
+#include "../../position.h"
+#include "../../rank.h"
+#include "../../square.h"
+#include "../../uci_move.h"
+#include "bitboard.h"
+#include "castling_rules.h"
+#include "piece_placement.h"
+#include "piece_placement_bitboards.h"
+#include "piece_placement_piece_at.h"
+#include "position_origins.h"
+#include "rank.h"
+#include "raw_move.h"
+#include "square.h"
+#include "uci_move.h"
+
+namespace chesscxx::internal {
+
+// What the side to move needs to know about its own king to tell whether a
+// move leaves it in check. Computed once per position and shared by all its
+// moves.
+struct KingSafety {
+  size_t king = 0;
+  // Opponent pieces giving check.
+  Bitboard checkers = 0;
+  // Pieces of the side to move that may only move along the line between
+  // their king and the slider pinning them.
+  Bitboard pinned = 0;
+};
+
+inline auto kingSafety(const Position& position) -> KingSafety {
+  using Bitboards = PiecePlacementBitboards;
+
+  const auto& piece_placement = position.piecePlacement();
+  auto us = position.activeColor();
+
+  KingSafety safety;
+  safety.king =
+      lsbIndex(Bitboards::pieces(piece_placement, us, PieceType::kKing));
+  safety.checkers =
+      attackersTo(piece_placement, safety.king,
+                  Bitboards::occupancy(piece_placement)) &
+      Bitboards::pieces(piece_placement, !us);
+  safety.pinned = sliderBlockers(piece_placement, safety.king, !us) &
+                  Bitboards::pieces(piece_placement, us);
+
+  return safety;
+}
+
+// The squares a castling king or rook passes through, its destination
+// included and its origin excluded.
+constexpr auto castlingPath(const RawMove& move) -> Bitboard {
+  return squaresBetween(index(move.origin), index(move.destination)) |
+         squareBit(move.destination);
+}
+
+inline auto isPseudoLegalCastling(const Position& position,
+                                  const CastlingSide& side) -> bool {
+  auto us = position.activeColor();
+  if (!position.castlingRights().canCastle(side, us)) return false;
+
+  auto moves = castlingMoves(side, us);
+  auto occupancy =
+      PiecePlacementBitboards::occupancy(position.piecePlacement()) &
+      ~squareBit(moves.king_move.origin) & ~squareBit(moves.rook_move.origin);
+
+  return ((castlingPath(moves.king_move) | castlingPath(moves.rook_move)) &
+          occupancy) == 0;
+}
+
+inline auto isLegalCastling(const Position& position, const CastlingSide& side)
+    -> bool {
+  using Bitboards = PiecePlacementBitboards;
+
+  const auto& piece_placement = position.piecePlacement();
+  auto us = position.activeColor();
+  auto moves = castlingMoves(side, us);
+
+  auto occupancy = Bitboards::occupancy(piece_placement) &
+                   ~squareBit(moves.king_move.origin) &
+                   ~squareBit(moves.rook_move.origin);
+  auto opponent_pieces = Bitboards::pieces(piece_placement, !us);
+
+  auto path =
+      castlingPath(moves.king_move) | squareBit(moves.king_move.origin);
+  while (path != 0) {
+    if ((attackersTo(piece_placement, popLsb(path), occupancy) &
+         opponent_pieces) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether the move could be made if the king's safety were set aside: the
+// side to move has a piece on the origin that can reach the destination, and
+// the move names a promotion piece exactly when a pawn reaches the last rank.
+inline auto isPseudoLegal(const Position& position, const UciMove& move)
+    -> bool {
+  const auto& piece_placement = position.piecePlacement();
+  auto us = position.activeColor();
+
+  auto piece = pieceAt(piece_placement, move.origin);
+  if (!piece || piece->color != us) return false;
+
+  if (auto side = castlingSideFromUci(piece_placement, move, us)) {
+    return isPseudoLegalCastling(position, *side);
+  }
+
+  if ((originCandidates(position, move.destination, *piece) &
+       squareBit(move.origin)) == 0) {
+    return false;
+  }
+
+  bool const is_promotion = piece->type == PieceType::kPawn &&
+                            move.destination.rank == promotionRank(us);
+  return move.promotion.has_value() == is_promotion;
+}
+
+// Whether the move, assumed to be pseudo-legal, keeps the own king out of
+// check. Nothing is moved: a king move looks for attackers of its
+// destination, and any other move must block or capture the only checker and
+// must stay on the line of its pin.
+inline auto isLegal(const Position& position, const KingSafety& safety,
+                    const UciMove& move) -> bool {
+  using Bitboards = PiecePlacementBitboards;
+
+  const auto& piece_placement = position.piecePlacement();
+  auto us = position.activeColor();
+  auto origin = index(move.origin);
+  auto destination_bit = squareBit(move.destination);
+
+  if (origin == safety.king) {
+    if (auto side = castlingSideFromUci(piece_placement, move, us)) {
+      return isLegalCastling(position, *side);
+    }
+
+    return (attackersTo(piece_placement, index(move.destination),
+                        Bitboards::occupancy(piece_placement) &
+                            ~squareBit(origin)) &
+            Bitboards::pieces(piece_placement, !us)) == 0;
+  }
+
+  // An en passant capture clears two squares at once, which pins cannot
+  // describe, so the king's attackers are looked up again.
+  if (move.destination == position.enPassantTargetSquare() &&
+      hasPieceAt(piece_placement, move.origin,
+                 {.type = PieceType::kPawn, .color = us})) {
+    if (auto captured_pawn_square =
+            enPassantCapturedPawnSquare(move.destination, us)) {
+      return !enPassantCaptureResultsInSelfCheck(
+          piece_placement, rawMoveFromUci(move), *captured_pawn_square, us);
+    }
+  }
+
+  if (safety.checkers != 0) {
+    if (!isSingleBit(safety.checkers)) return false;
+
+    auto checker = lsbIndex(safety.checkers);
+    if (((squaresBetween(safety.king, checker) | safety.checkers) &
+         destination_bit) == 0) {
+      return false;
+    }
+  }
+
+  if ((safety.pinned & squareBit(origin)) != 0) {
+    return (lineThrough(origin, safety.king) & destination_bit) != 0;
+  }
+
+  return true;
+}
+
+inline auto isLegal(const Position& position, const UciMove& move) -> bool {
+  return isPseudoLegal(position, move) &&
+         isLegal(position, kingSafety(position), move);
+}
+
+// Whether the side to move has a legal move, found with bitboards alone and
+// without generating any. King steps come first: they are the only moves
+// left in double check and often the only ones in endgames. The other
+// pieces follow, from the cheapest to test. Castling is left out, as it
+// needs the square next to the king to be empty and safe, which makes the
+// king step onto it legal too.
+inline auto hasLegalMove(const Position& position) -> bool {
+  using Bitboards = PiecePlacementBitboards;
+
+  const auto& piece_placement = position.piecePlacement();
+  auto us = position.activeColor();
+  auto safety = kingSafety(position);
+  auto occupancy = Bitboards::occupancy(piece_placement);
+  auto ours = Bitboards::pieces(piece_placement, us);
+  auto theirs = Bitboards::pieces(piece_placement, !us);
+
+  // Without the king, sliders see through the square it steps away from.
+  auto without_king = occupancy & ~squareBit(safety.king);
+  for (auto steps = kingAttacks(safety.king) & ~ours; steps != 0;) {
+    if ((attackersTo(piece_placement, popLsb(steps), without_king) &
+         theirs) == 0) {
+      return true;
+    }
+  }
+  if (safety.checkers != 0 && !isSingleBit(safety.checkers)) return false;
+
+  // In check, the other pieces must capture the checker or block it.
+  auto targets = ~ours;
+  if (safety.checkers != 0) {
+    targets = squaresBetween(safety.king, lsbIndex(safety.checkers)) |
+              safety.checkers;
+  }
+  auto has_move = [&](size_t origin, Bitboard destinations) {
+    if ((safety.pinned & squareBit(origin)) != 0) {
+      destinations &= lineThrough(origin, safety.king);
+    }
+    return (destinations & targets) != 0;
+  };
+
+  for (auto type : {PieceType::kKnight, PieceType::kBishop, PieceType::kRook,
+                    PieceType::kQueen}) {
+    for (auto pieces = Bitboards::pieces(piece_placement, us, type);
+         pieces != 0;) {
+      auto origin = popLsb(pieces);
+      if (has_move(origin, pieceAttacks(type, origin, occupancy))) {
+        return true;
+      }
+    }
+  }
+
+  bool const white = us == Color::kWhite;
+  auto forward = [white](Bitboard bitboard) {
+    return white ? bitboard >> kNumFiles : bitboard << kNumFiles;
+  };
+  auto double_push_rank =
+      rankBitboard(index(white ? Rank::k4 : Rank::k5) * kNumFiles);
+  for (auto pawns = Bitboards::pieces(piece_placement, us, PieceType::kPawn);
+       pawns != 0;) {
+    auto origin = popLsb(pawns);
+    auto push = forward(squareBit(origin)) & ~occupancy;
+    auto double_push = forward(push) & ~occupancy & double_push_rank;
+    auto captures = pawnAttacks(us, origin) & theirs;
+    if (has_move(origin, push | double_push | captures)) return true;
+  }
+
+  // An en passant capture clears two squares at once, which pins cannot
+  // describe. Its legality is settled when the pawn being captured moves.
+  return position.legalEnPassantTargetSquare().has_value();
+}
+
+}  // namespace chesscxx::internal
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_POSITION_LEGALITY_H_
@@ -9,15 +9,19 @@
 #include "../../check_indicator.h"
 #include "../../color.h"
 #include "../../move_error.h"
+#include "../../movegen/internal/position_movegen.h"
 #include "../../piece_type.h"
 #include "../../position.h"
 #include "../../san_move.h"
+#include "../../square.h"
+#include "../../stats.h"
 #include "../../uci_move.h"
 #include "castling_rules.h"
 #include "move_record.h"
 #include "piece_placement.h"
 #include "piece_placement_piece_at.h"
 #include "position.h"
+#include "position_check.h"
 #include "rank.h"
 #include "raw_move.h"
 #include "square.h"
@@ -35,19 +39,22 @@ class PositionModifier {
   template <typename MoveNotation>
   static auto move(Position& position, const MoveNotation& move)
       -> std::expected<MoveRecord, MoveError> {
+    recordStat(&stats::Counters::position_moves);
     auto result = executeMove(position, move);
 
     if (result) {
       position.toggleActiveColor();
 
-      if (isCheckmate(position)) {
+      // Only a check can be a checkmate, so the search for a legal reply is
+      // skipped for every other move.
+      bool const is_check = std::visit(
+          [](const auto& arg) { return arg.check_indicator.has_value(); },
+          *result);
+
+      if (is_check && !hasLegalMove(position)) {
         std::visit(
             [](auto& arg) { arg.check_indicator = CheckIndicator::kCheckmate; },
             *result);
-      } else if (isCheck(position)) {
-        std::visit(
-            [](auto& arg) { arg.check_indicator = CheckIndicator::kCheck; },
-            *result);
       }
     }
 
@@ -58,6 +65,36 @@ class PositionModifier {
     std::visit([&](const auto& arg) { undoMove(position, arg); }, move);
   }
 
+  // Passes the turn without moving a piece. The counters advance as for a
+  // quiet move, and the en passant file is cleared.
+  static auto makeNullMove(Position& position)
+      -> std::expected<NullMoveRecord, MoveError> {
+    if (auto error = overflowError(position)) {
+      return std::unexpected(error.value());
+    }
+
+    if (isCheck(position)) {
+      return std::unexpected(MoveError::kMoveLeavesOwnKingInCheck);
+    }
+
+    NullMoveRecord move = {
+        .previous_en_passant_file = position.en_passant_file_,
+        .previous_halfmove_clock = position.halfmoveClock(),
+    };
+
+    position.resetEnPassantFile();
+    position.incrementMoveCounters();
+    position.toggleActiveColor();
+
+    return move;
+  }
+
+  static void undoNullMove(Position& position, const NullMoveRecord& move) {
+    position.halfmove_clock_ = move.previous_halfmove_clock;
+
+    undoCommonMoveEffects(position, move);
+  }
+
  private:
   static auto executeMove(Position& position, const SanMove& move)
       -> std::expected<MoveRecord, MoveError> {
@@ -119,6 +156,7 @@ class PositionModifier {
     auto captured_pawn_square =
         enPassantCapturedPawnSquare(uci.destination, active_color);
     auto partial_origin = partialOriginFromMove(position, rawMoveFromUci(uci));
+    bool const gives_check = givesCheck(position, uci);
 
     bool const is_en_passant_capture =
         is_pawn_move && position.enPassantTargetSquare() == uci.destination &&
@@ -147,6 +185,8 @@ class PositionModifier {
         move_record.captured_piece_type = destination_piece->type;
       }
 
+      if (gives_check) move_record.check_indicator = CheckIndicator::kCheck;
+
       // Update castling rights
       updateCastlingRights(position, rawMoveFromUci(uci));
 
@@ -201,7 +241,11 @@ class PositionModifier {
 
     if (!is_double_push) return;
 
+    // The opponent captures next, so whether they can is known now.
+    Square const target(dest.file, enPassantRank(!active_color));
     position.en_passant_file_ = dest.file;
+    position.is_en_passant_legal_ = hasLegalEnPassantCapture(
+        position.piece_placement_, target, !active_color);
   }
 
   static auto executeCastling(Position& position, const CastlingSide& side)
@@ -218,6 +262,9 @@ class PositionModifier {
       return std::unexpected(MoveError::kKingOrRookMoved);
     }
 
+    bool const gives_check =
+        castlingGivesCheck(position, checkInfo(position), side);
+
     auto result = PiecePlacementModifier::doCastling(position.piece_placement_,
                                                      side, active_color);
 
@@ -230,6 +277,8 @@ class PositionModifier {
           .previous_en_passant_file = en_passant_file,
       };
 
+      if (gives_check) move.check_indicator = CheckIndicator::kCheck;
+
       position.castling_rights_.disable(active_color);
       position.resetEnPassantFile();
       position.incrementMoveCounters();
@@ -246,6 +295,7 @@ class PositionModifier {
     if (position.activeColor() == Color::kWhite) position.fullmove_number_ -= 1;
 
     position.toggleActiveColor();
+    position.updateEnPassantLegality();
   }
 
   static void undoMove(Position& position, const NormalMoveRecord& move) {
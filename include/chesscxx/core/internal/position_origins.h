@@ -0,0 +1,132 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_POSITION_ORIGINS_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_POSITION_ORIGINS_H_
+
+#include <cstddef>
+#include <optional>
+
+#include "../../color.h"
+#include "../../partial_square.h"
+#include "../../piece.h"
+#include "../../piece_placement.h"
+#include "../../piece_type.h"
+#include "../../position.h"
+#include "../../square.h"
+#include "bitboard.h"
+#include "file.h"
+#include "piece_placement_bitboards.h"
+#include "rank.h"
+#include "square.h"
+
+namespace chesscxx::internal {
+
+// The square a pawn pushed to the given empty square comes from: the first
+// occupied square behind it, looking two squares back on the double push
+// target rank.
+inline auto pawnPushOrigin(const PiecePlacement& piece_placement,
+                           const Square& destination, const Color& color)
+    -> Bitboard {
+  using Bitboards = PiecePlacementBitboards;
+
+  auto occupancy = Bitboards::occupancy(piece_placement);
+  if ((occupancy & squareBit(destination)) != 0) return 0;
+
+  auto source = squareBehind(destination, 1, color);
+  if (!source) return 0;
+
+  if ((occupancy & squareBit(*source)) == 0 &&
+      isDoublePawnPushTargetRank(destination.rank, color)) {
+    source = squareBehind(destination, 2, color);
+  }
+
+  return squareBit(*source) &
+         Bitboards::pieces(piece_placement, color, PieceType::kPawn);
+}
+
+// Squares of the pieces that can move to the destination when checks and pins
+// are set aside. These are the squares piecesReaching() yields.
+inline auto originCandidates(const Position& position,
+                             const Square& destination, const Piece& piece)
+    -> Bitboard {
+  using Bitboards = PiecePlacementBitboards;
+
+  const auto& piece_placement = position.piecePlacement();
+  auto destination_bit = squareBit(destination);
+  if ((Bitboards::pieces(piece_placement, piece.color) & destination_bit) !=
+      0) {
+    return 0;
+  }
+
+  auto own_pieces = Bitboards::pieces(piece_placement, piece.color, piece.type);
+  auto destination_index = index(destination);
+
+  if (piece.type != PieceType::kPawn) {
+    return pieceAttacks(piece.type, destination_index,
+                        Bitboards::occupancy(piece_placement)) &
+           own_pieces;
+  }
+
+  Bitboard candidates = 0;
+  if ((Bitboards::pieces(piece_placement, !piece.color) & destination_bit) !=
+          0 ||
+      destination == position.enPassantTargetSquare()) {
+    candidates |= pawnAttacks(!piece.color, destination_index) & own_pieces;
+  }
+
+  return candidates | pawnPushOrigin(piece_placement, destination, piece.color);
+}
+
+// The candidates that can move to the destination without leaving a pinned
+// line, which is all SAN takes into account to tell them apart.
+inline auto unpinnedOrigins(const PiecePlacement& piece_placement,
+                            Bitboard candidates, const Square& destination,
+                            const Color& color) -> Bitboard {
+  auto kings =
+      PiecePlacementBitboards::pieces(piece_placement, color, PieceType::kKing);
+  if (kings == 0) return candidates;
+
+  auto king = lsbIndex(kings);
+  auto pinned = sliderBlockers(piece_placement, king, !color) & candidates;
+  auto destination_bit = squareBit(destination);
+
+  auto unpinned = candidates & ~pinned;
+  while (pinned != 0) {
+    auto square_index = popLsb(pinned);
+    if ((lineThrough(square_index, king) & destination_bit) != 0) {
+      unpinned |= squareBit(square_index);
+    }
+  }
+  return unpinned;
+}
+
+// The squares matching a partial square.
+inline auto partialSquareBitboard(const PartialSquare& partial) -> Bitboard {
+  auto bitboard = ~Bitboard{0};
+  if (partial.file) {
+    bitboard &= fileBitboard(index(*partial.file));
+  }
+  if (partial.rank) {
+    bitboard &= rankBitboard(index(*partial.rank) * kNumFiles);
+  }
+  return bitboard;
+}
+
+// The part of the origin that tells it apart from the other candidates.
+inline auto disambiguatingOrigin(Bitboard candidates, const Square& origin)
+    -> PartialSquare {
+  if (isSingleBit(candidates)) return PartialSquare{};
+
+  auto origin_index = index(origin);
+  if (isSingleBit(candidates & fileBitboard(origin_index))) {
+    return PartialSquare(origin.file, std::nullopt);
+  }
+
+  if (isSingleBit(candidates & rankBitboard(origin_index))) {
+    return PartialSquare(std::nullopt, origin.rank);
+  }
+
+  return PartialSquare(origin.file, origin.rank);
+}
+
+}  // namespace chesscxx::internal
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_POSITION_ORIGINS_H_
@@ -40,11 +40,11 @@ constexpr auto backRank(const Color& color) -> Rank {
   return color == Color::kWhite ? Rank::k1 : Rank::k8;
 }
 
-inline auto promotionRank(const Color& color) -> Rank {
+constexpr auto promotionRank(const Color& color) -> Rank {
   return color == Color::kWhite ? Rank::k8 : Rank::k1;
 }
 
-inline auto enPassantRank(const Color& color) -> Rank {
+constexpr auto enPassantRank(const Color& color) -> Rank {
   return color == Color::kWhite ? Rank::k6 : Rank::k3;
 }
 
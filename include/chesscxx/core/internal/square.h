@@ -105,8 +105,8 @@ inline auto isValidEnPassantTargetSquare(const std::optional<Square>& square,
   return square->rank == enPassantRank(color);
 }
 
-inline auto enPassantCapturedPawnSquare(const Square& en_passant_target_square,
-                                        const Color& attacker_color) {
+constexpr auto enPassantCapturedPawnSquare(
+    const Square& en_passant_target_square, const Color& attacker_color) {
   return internal::squareBehind(en_passant_target_square, 1, attacker_color);
 }
 
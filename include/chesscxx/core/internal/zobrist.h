@@ -0,0 +1,82 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_ZOBRIST_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_ZOBRIST_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "../../color.h"
+#include "../../file.h"
+#include "../../piece.h"
+#include "../../square.h"
+#include "bitboard.h"
+#include "file.h"
+
+namespace chesscxx::internal {
+
+using ZobristKey = uint64_t;
+
+inline constexpr size_t kNumCastlingRightsCombinations = 16;
+
+// Random keys for Zobrist hashing. They are generated at compile time with
+// SplitMix64 from a fixed seed, so every build computes the same keys.
+struct ZobristKeys {
+  std::array<std::array<std::array<ZobristKey, kNumSquares>, kNumPieceTypes>,
+             kNumColors>
+      pieces{};
+  ZobristKey black_to_move = 0;
+  std::array<ZobristKey, kNumCastlingRightsCombinations> castling_rights{};
+  std::array<ZobristKey, kNumFiles> en_passant_files{};
+};
+
+constexpr auto splitMix64(uint64_t& state) -> ZobristKey {
+  state += 0x9E3779B97F4A7C15;
+  auto key = state;
+  key = (key ^ (key >> 30U)) * 0xBF58476D1CE4E5B9;
+  key = (key ^ (key >> 27U)) * 0x94D049BB133111EB;
+  return key ^ (key >> 31U);
+}
+
+constexpr auto makeZobristKeys() -> ZobristKeys {
+  uint64_t state = 0x43686573735A6F62;  // "ChessZob"
+  ZobristKeys keys;
+
+  for (auto& color_keys : keys.pieces) {
+    for (auto& type_keys : color_keys) {
+      for (auto& key : type_keys) key = splitMix64(state);
+    }
+  }
+  keys.black_to_move = splitMix64(state);
+  // No castling rights at all leave the key unchanged.
+  for (size_t i = 1; i < kNumCastlingRightsCombinations; ++i) {
+    keys.castling_rights.at(i) = splitMix64(state);
+  }
+  for (auto& key : keys.en_passant_files) key = splitMix64(state);
+
+  return keys;
+}
+
+inline constexpr ZobristKeys kZobristKeys = makeZobristKeys();
+
+constexpr auto zobristKey(const Piece& piece, const Square& square)
+    -> ZobristKey {
+  return kZobristKeys.pieces.at(colorIndex(piece.color))
+      .at(pieceTypeIndex(piece.type))
+      .at(index(square));
+}
+
+constexpr auto zobristSideKey(const Color& active_color) -> ZobristKey {
+  return active_color == Color::kBlack ? kZobristKeys.black_to_move : 0;
+}
+
+constexpr auto zobristCastlingKey(size_t castling_rights_bits) -> ZobristKey {
+  return kZobristKeys.castling_rights.at(castling_rights_bits);
+}
+
+constexpr auto zobristEnPassantKey(const File& file) -> ZobristKey {
+  return kZobristKeys.en_passant_files.at(index(file));
+}
+
+}  // namespace chesscxx::internal
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_CORE_INTERNAL_ZOBRIST_H_
@@ -18,13 +18,17 @@
 #include "../piece_type.h"
 #include "../rank.h"
 #include "../square.h"
+#include "../stats.h"
+#include "internal/bitboard.h"
 #include "internal/rank.h"
 #include "internal/square.h"
+#include "internal/zobrist.h"
 
 namespace chesscxx {
 namespace internal {
-// Forward declaration
+// Forward declarations
 class PiecePlacementModifier;
+class PiecePlacementBitboards;
 }  // namespace internal
 
 /// @brief Represents the piece placement on a chess board.
@@ -47,7 +51,11 @@ class PiecePlacement {
 
   /// @brief Default constructor. Initializes the board with the standard chess
   /// starting position.
-  constexpr PiecePlacement();
+  ///
+  /// Copies a cached start position instead of rebuilding it square by
+  /// square. The piece array is copied flat, but the piece location maps are
+  /// still deep-copied, which costs one allocation per map and set.
+  PiecePlacement();
 
   /// @}
 
@@ -94,6 +102,7 @@ class PiecePlacement {
 
  private:
   friend class internal::PiecePlacementModifier;
+  friend class internal::PiecePlacementBitboards;
 
   constexpr explicit PiecePlacement(const PieceArray& piece_array) {
     for (uint8_t i = 0; i < kNumSquares; ++i) {
@@ -108,7 +117,17 @@ class PiecePlacement {
 
   constexpr void updatePieceAt(const Square& square,
                                const std::optional<Piece>& new_piece) {
+    internal::recordStat(&stats::Counters::piece_updates);
+
+    auto bit = internal::squareBit(square);
+
     if (auto previous = pieceAt(square)) {
+      color_bitboards_.at(internal::colorIndex(previous->color)) &= ~bit;
+      type_bitboards_.at(internal::pieceTypeIndex(previous->type)) &= ~bit;
+      zobrist_key_ ^= internal::zobristKey(*previous, square);
+      if (previous->type == PieceType::kPawn) {
+        pawn_key_ ^= internal::zobristKey(*previous, square);
+      }
       piece_locations_[previous->color][previous->type].erase(square);
       if (piece_locations_[previous->color][previous->type].empty()) {
         piece_locations_[previous->color].erase(previous->type);
@@ -116,6 +135,12 @@ class PiecePlacement {
     }
 
     if (new_piece) {
+      color_bitboards_.at(internal::colorIndex(new_piece->color)) |= bit;
+      type_bitboards_.at(internal::pieceTypeIndex(new_piece->type)) |= bit;
+      zobrist_key_ ^= internal::zobristKey(*new_piece, square);
+      if (new_piece->type == PieceType::kPawn) {
+        pawn_key_ ^= internal::zobristKey(*new_piece, square);
+      }
       piece_locations_[new_piece->color][new_piece->type].insert(square);
     }
 
@@ -177,6 +202,10 @@ class PiecePlacement {
 
   PieceArray piece_array_;
   PieceLocationsByTypeAndColor piece_locations_;
+  std::array<internal::Bitboard, internal::kNumColors> color_bitboards_{};
+  std::array<internal::Bitboard, internal::kNumPieceTypes> type_bitboards_{};
+  internal::ZobristKey zobrist_key_ = 0;
+  internal::ZobristKey pawn_key_ = 0;
 };
 
 }  // namespace chesscxx
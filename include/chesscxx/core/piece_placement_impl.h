@@ -10,12 +10,17 @@
 namespace chesscxx {
 
 namespace internal {
-constexpr auto standardStartPosition() -> PiecePlacement {
-  return *parse<PiecePlacement>("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR");
+// Parsed once, on first use. The hash maps of a PiecePlacement cannot be
+// built at compile time, so default construction copies this one instead of
+// parsing the FEN again.
+inline auto standardStartPosition() -> const PiecePlacement& {
+  static const auto kStartPosition =
+      *parse<PiecePlacement>("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR");
+  return kStartPosition;
 }
 }  // namespace internal
 
-constexpr PiecePlacement::PiecePlacement()
+inline PiecePlacement::PiecePlacement()
     : PiecePlacement(internal::standardStartPosition()) {}
 
 }  // namespace chesscxx
@@ -73,7 +73,7 @@ class Position {
 
   /// @brief Default constructor. Constructs a Position representing the
   /// standard chess starting position.
-  constexpr Position() = default;
+  Position() = default;
 
   /// @}
 
@@ -93,6 +93,7 @@ class Position {
 
     if (auto error = position.validationError()) return std::unexpected(*error);
 
+    position.updateEnPassantLegality();
     return position;
   }
 
@@ -126,11 +127,21 @@ class Position {
                : std::nullopt;
   }
   /// @brief Returns the en passant target square if it's legally capturable.
-  auto legalEnPassantTargetSquare() const -> std::optional<Square>;
+  auto legalEnPassantTargetSquare() const -> std::optional<Square> {
+    return is_en_passant_legal_ ? enPassantTargetSquare() : std::nullopt;
+  }
   /// @brief Returns the halfmove clock.
   auto halfmoveClock() const -> const uint32_t& { return halfmove_clock_; }
   /// @brief Returns the fullmove number.
   auto fullmoveNumber() const -> const uint32_t& { return fullmove_number_; }
+  /// @brief Returns the Zobrist key of the position. It covers the pieces, the
+  /// side to move, the castling rights and the en passant file when the
+  /// capture is legal. The move counters are not part of it.
+  auto zobristKey() const -> uint64_t;
+  /// @brief Returns the Zobrist key of the pawn structure. It covers the
+  /// squares and colors of the pawns only, so it stays the same while no pawn
+  /// moves, is captured or promotes.
+  auto pawnKey() const -> uint64_t;
 
   /// @}
 
@@ -219,12 +230,26 @@ class Position {
     if (active_color_ == Color::kBlack) fullmove_number_++;
   }
   void resetHalfmoveClock() { halfmove_clock_ = 0; }
-  void resetEnPassantFile() { en_passant_file_.reset(); }
+  void resetEnPassantFile() {
+    en_passant_file_.reset();
+    is_en_passant_legal_ = false;
+  }
+
+  // Whether the capture is legal only changes with the pieces, so it is
+  // worked out once whenever the target square or the pieces are set rather
+  // than every time the position is hashed or compared.
+  void updateEnPassantLegality() {
+    auto target_square = enPassantTargetSquare();
+    is_en_passant_legal_ =
+        target_square && internal::hasLegalEnPassantCapture(
+                             piece_placement_, *target_square, active_color_);
+  }
 
   PiecePlacement piece_placement_;
   Color active_color_ = Color::kWhite;
   CastlingRights castling_rights_;
   std::optional<File> en_passant_file_ = std::nullopt;
+  bool is_en_passant_legal_ = false;
   uint32_t halfmove_clock_ = kMinHalfmoveClock;
   uint32_t fullmove_number_ = kMinFullmoveNumber;
 };
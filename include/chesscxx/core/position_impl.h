@@ -3,19 +3,32 @@
 
 // IWYU pragma: private, include "../position.h"
 
-#include <optional>
+#include <cstdint>
 
-#include "../movegen/internal/position_en_passant_movegen.h"
-#include "../square.h"
+#include "../color.h"
+#include "internal/piece_placement_bitboards.h"
+#include "internal/zobrist.h"
 #include "position.h"
 
 namespace chesscxx {
 
-inline auto Position::legalEnPassantTargetSquare() const
-    -> std::optional<Square> {
-  if (internal::hasLegalEnPassantCapture(*this)) return enPassantTargetSquare();
+inline auto Position::zobristKey() const -> uint64_t {
+  using Bitboards = internal::PiecePlacementBitboards;
 
-  return std::nullopt;
+  auto key =
+      Bitboards::zobristKey(piece_placement_) ^
+      internal::zobristSideKey(active_color_) ^
+      internal::zobristCastlingKey(castling_rights_.toBitset().to_ulong());
+
+  if (is_en_passant_legal_) {
+    key ^= internal::zobristEnPassantKey(*en_passant_file_);
+  }
+
+  return key;
+}
+
+inline auto Position::pawnKey() const -> uint64_t {
+  return internal::PiecePlacementBitboards::pawnKey(piece_placement_);
 }
 
 }  // namespace chesscxx
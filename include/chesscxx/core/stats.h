@@ -0,0 +1,129 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_CORE_STATS_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_CORE_STATS_H_
+
+// IWYU pragma: private, include "../stats.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace chesscxx::stats {
+
+/// @defgroup StatsGroup Instrumentation counters
+/// @{
+
+/// @brief True when the library is built with `CHESSCXX_ENABLE_STATS`.
+/// Otherwise every counter hook compiles to nothing and snapshot() always
+/// returns zeroed counters.
+#ifdef CHESSCXX_ENABLE_STATS
+inline constexpr bool kEnabled = true;
+#else
+inline constexpr bool kEnabled = false;
+#endif
+
+/// @brief Number of times each instrumented hot path was executed by a thread.
+struct Counters {
+  /// @brief Legal move generations started.
+  uint64_t legal_move_generations = 0;
+  /// @brief Checks of whether a move leaves the mover's king in check.
+  uint64_t self_check_tests = 0;
+  /// @brief Single-square updates of a piece placement.
+  uint64_t piece_updates = 0;
+  /// @brief Queries of whether a square is attacked.
+  uint64_t attack_queries = 0;
+  /// @brief Moves applied to a position, including those made while
+  /// generating SAN moves.
+  uint64_t position_moves = 0;
+  /// @brief Moves applied to a game.
+  uint64_t game_moves = 0;
+  /// @brief Coroutine frames allocated by the move generators.
+  uint64_t coroutine_frames = 0;
+  /// @brief Lookups and updates of a game's repetition tracker.
+  uint64_t repetition_probes = 0;
+
+  /// @brief Compares two Counters objects for equality.
+  constexpr auto operator==(const Counters&) const -> bool = default;
+};
+
+/// @brief Returns a copy of the calling thread's counters.
+inline auto snapshot() -> Counters;
+
+/// @brief Resets the calling thread's counters to zero.
+inline void reset();
+
+/// @}
+
+}  // namespace chesscxx::stats
+
+namespace chesscxx::internal {
+
+inline auto threadStats() -> stats::Counters& {
+  thread_local stats::Counters counters;
+  return counters;
+}
+
+constexpr void recordStat(uint64_t stats::Counters::* counter) {
+  if constexpr (stats::kEnabled) {
+    if !consteval {
+      ++(threadStats().*counter);
+    }
+  }
+}
+
+template <typename T, typename Allocator>
+class StatsAllocator {
+ public:
+  using value_type = T;
+
+  explicit StatsAllocator(const Allocator& alloc) : alloc_(alloc) {}
+
+  template <typename U>
+  explicit StatsAllocator(const StatsAllocator<U, Allocator>& other)
+      : alloc_(other.underlying()) {}
+
+  auto allocate(std::size_t count) -> T* {
+    recordStat(&stats::Counters::coroutine_frames);
+    Rebound rebound(alloc_);
+    return std::allocator_traits<Rebound>::allocate(rebound, count);
+  }
+
+  void deallocate(T* pointer, std::size_t count) {
+    Rebound rebound(alloc_);
+    std::allocator_traits<Rebound>::deallocate(rebound, pointer, count);
+  }
+
+  auto underlying() const -> const Allocator& { return alloc_; }
+
+  template <typename U>
+  auto operator==(const StatsAllocator<U, Allocator>& other) const -> bool {
+    return alloc_ == other.underlying();
+  }
+
+ private:
+  using Rebound =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+  Allocator alloc_;
+};
+
+// Wraps the allocator of a coroutine frame so that its allocations are counted
+// when stats are enabled. Returns the allocator unchanged otherwise.
+template <typename Allocator>
+auto statsAllocator(const Allocator& alloc) {
+  if constexpr (stats::kEnabled) {
+    return StatsAllocator<typename Allocator::value_type, Allocator>(alloc);
+  } else {
+    return alloc;
+  }
+}
+
+}  // namespace chesscxx::internal
+
+namespace chesscxx::stats {
+
+inline auto snapshot() -> Counters { return internal::threadStats(); }
+
+inline void reset() { internal::threadStats() = Counters{}; }
+
+}  // namespace chesscxx::stats
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_CORE_STATS_H_
@@ -0,0 +1,69 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_CORE_UPCOMING_REPETITION_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_CORE_UPCOMING_REPETITION_H_
+
+// IWYU pragma: private, include "../game.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+#include "game.h"
+#include "internal/bitboard.h"
+#include "internal/cuckoo.h"
+#include "internal/piece_placement_bitboards.h"
+
+namespace chesscxx {
+
+/// @brief Indicates whether the side to move can repeat an earlier position
+/// of the game with a single move.
+///
+/// The keys of the positions since the last capture, pawn move or null move
+/// are looked up in a table of the moves that can undo each other, so no move
+/// is generated and the cost grows with halfmoveClock() alone.
+/// @param game The game to look into.
+/// @param ply The number of the game's last plies whose positions count as
+/// repeated as soon as they occur again, as a search exploring them needs.
+/// Older positions must already have occurred twice, so that the move would
+/// bring about a threefold repetition.
+inline auto hasUpcomingRepetition(const Game& game, int ply = 0) -> bool {
+  using Bitboards = internal::PiecePlacementBitboards;
+
+  const auto& keys = game.zobristKeys();
+  const auto& position = game.currentPosition();
+  auto end =
+      std::min<size_t>(position.halfmoveClock(), game.pliesSinceNullMove());
+  if (end < 3) return false;
+
+  // Positions older than the last capture, pawn move or null move cannot
+  // come back.
+  auto reversible = std::prev(keys.end(), static_cast<std::ptrdiff_t>(end) + 1);
+  auto occupancy = Bitboards::occupancy(position.piecePlacement());
+  auto ours = Bitboards::pieces(position.piecePlacement(),
+                                position.activeColor());
+
+  // Only positions with the other side to move are a move of ours away.
+  for (size_t i = 3; i <= end; i += 2) {
+    auto earlier_key = keys.at(keys.size() - 1 - i);
+    auto move = internal::findCuckooMove(keys.back() ^ earlier_key);
+    if (!move) continue;
+
+    auto first = internal::squareBit(move->first_square);
+    auto second = internal::squareBit(move->second_square);
+    if ((internal::squaresBetween(move->first_square, move->second_square) &
+         occupancy) != 0) {
+      continue;
+    }
+    // The move may be one of the opponent's, played in either direction.
+    if (((occupancy & first) != 0 ? ours & first : ours & second) == 0) {
+      continue;
+    }
+
+    if (static_cast<int>(i) < ply) return true;
+    if (std::count(reversible, keys.end(), earlier_key) >= 2) return true;
+  }
+  return false;
+}
+
+}  // namespace chesscxx
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_CORE_UPCOMING_REPETITION_H_
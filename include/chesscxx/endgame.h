@@ -0,0 +1,8 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_ENDGAME_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_ENDGAME_H_
+
+/// @defgroup EndgameGroup Endgames
+#include "endgame/bitbase.h"         // IWYU pragma: export
+#include "endgame/bitbase_result.h"  // IWYU pragma: export
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_ENDGAME_H_
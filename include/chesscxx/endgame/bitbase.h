@@ -0,0 +1,72 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_ENDGAME_BITBASE_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_ENDGAME_BITBASE_H_
+
+// IWYU pragma: private, include "../endgame.h"
+
+#include <cstddef>
+#include <optional>
+
+#include "../color.h"
+#include "../file.h"
+#include "../piece_type.h"
+#include "../position.h"
+#include "bitbase_result.h"
+#include "internal/kpk_bitbase.h"
+#include "internal/lone_piece_endgame.h"
+
+namespace chesscxx {
+
+/// @addtogroup EndgameGroup
+/// @{
+
+/// @brief Looks up a king and pawn versus king position.
+///
+/// The bitbase is generated by retrograde analysis the first time it is
+/// probed, which takes milliseconds, and then takes 24 KiB. Draws by
+/// the fifty-move rule are not considered.
+/// @return Whether the side with the pawn wins, or std::nullopt if the
+/// position is not a king and pawn versus king position.
+inline auto probeKPK(const Position& position)
+    -> std::optional<BitbaseResult> {
+  static constexpr size_t kFlipRanks = 56;
+  static constexpr size_t kFlipFiles = 7;
+
+  auto squares = internal::lonePieceSquares(position, PieceType::kPawn);
+  if (!squares) return std::nullopt;
+
+  // The bitbase holds white pawns on files a to d only.
+  size_t flip = squares->strong_side == Color::kBlack ? kFlipRanks : 0;
+  if ((squares->piece % kNumFiles) >= internal::kKpkPawnFiles) {
+    flip |= kFlipFiles;
+  }
+  auto active_color = position.activeColor() == squares->strong_side
+                          ? Color::kWhite
+                          : Color::kBlack;
+
+  bool const win = internal::KpkBitbase::instance().isWin(
+      active_color, squares->strong_king ^ flip, squares->weak_king ^ flip,
+      squares->piece ^ flip);
+  return win ? BitbaseResult::kWin : BitbaseResult::kDraw;
+}
+
+/// @brief Looks up a king and rook versus king position.
+/// @return Whether the side with the rook wins, or std::nullopt if the
+/// position is not a king and rook versus king position.
+inline auto probeKRK(const Position& position)
+    -> std::optional<BitbaseResult> {
+  return internal::probeMajorPiece(position, PieceType::kRook);
+}
+
+/// @brief Looks up a king and queen versus king position.
+/// @return Whether the side with the queen wins, or std::nullopt if the
+/// position is not a king and queen versus king position.
+inline auto probeKQK(const Position& position)
+    -> std::optional<BitbaseResult> {
+  return internal::probeMajorPiece(position, PieceType::kQueen);
+}
+
+/// @}
+
+}  // namespace chesscxx
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_ENDGAME_BITBASE_H_
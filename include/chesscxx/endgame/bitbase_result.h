@@ -0,0 +1,22 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_ENDGAME_BITBASE_RESULT_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_ENDGAME_BITBASE_RESULT_H_
+
+// IWYU pragma: private, include "../endgame.h"
+
+#include <cstdint>
+
+namespace chesscxx {
+
+/// @ingroup EndgameGroup
+/// @brief The outcome of an endgame with perfect play, for the side with the
+/// extra material.
+enum class BitbaseResult : uint8_t {
+  /// @brief The side with the extra material wins.
+  kWin,
+  /// @brief The game is drawn.
+  kDraw,
+};
+
+}  // namespace chesscxx
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_ENDGAME_BITBASE_RESULT_H_
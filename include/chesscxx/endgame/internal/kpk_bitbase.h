@@ -0,0 +1,173 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_ENDGAME_INTERNAL_KPK_BITBASE_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_ENDGAME_INTERNAL_KPK_BITBASE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../../color.h"
+#include "../../core/internal/bitboard.h"
+#include "../../file.h"
+#include "../../square.h"
+
+namespace chesscxx::internal {
+
+// The king and pawn versus king positions with white holding the pawn, on
+// files a to d: the other files mirror them. Pawns stand on ranks 2 to 7.
+inline constexpr size_t kKpkPawnFiles = kNumFiles / 2;
+inline constexpr size_t kKpkPawnSquares = kKpkPawnFiles * 6;
+inline constexpr size_t kKpkSize =
+    kNumColors * kNumSquares * kNumSquares * kKpkPawnSquares;
+
+constexpr auto kpkIndex(const Color& active_color, size_t white_king,
+                        size_t black_king, size_t pawn) -> size_t {
+  auto pawn_row = (pawn / kNumFiles) - 1;
+  auto pawn_index = (pawn_row * kKpkPawnFiles) + (pawn % kNumFiles);
+  return white_king | (black_king << 6U) | (colorIndex(active_color) << 12U) |
+         (pawn_index << 13U);
+}
+
+// Whether white wins each KPK position, found by retrograde analysis.
+//
+// Positions are first classified on their own: illegal ones, wins by safe
+// promotion, and draws by stalemate or by capturing the undefended pawn.
+// The rest are then classified from their successors until nothing changes:
+// white wins when one move leads to a win, black draws when one move leads
+// to a draw. Whatever is still unknown is a draw, as white cannot force a
+// win from it. A promotion the black king cannot answer by taking the new
+// queen counts as a win, so K+Q vs K is never searched: where the queen
+// would stalemate, a rook or another move still wins.
+class KpkBitbase {
+ public:
+  static auto instance() -> const KpkBitbase& {
+    static const KpkBitbase kBitbase;
+    return kBitbase;
+  }
+
+  auto isWin(const Color& active_color, size_t white_king, size_t black_king,
+             size_t pawn) const -> bool {
+    auto i = kpkIndex(active_color, white_king, black_king, pawn);
+    return ((wins_.at(i / 64) >> (i % 64)) & 1U) != 0;
+  }
+
+ private:
+  // Bit flags, so a position's successors can be summed up with an OR.
+  enum Result : uint8_t {
+    kInvalid = 0,
+    kUnknown = 1,
+    kDraw = 2,
+    kWin = 4,
+  };
+
+  struct Entry {
+    Color active_color;
+    uint8_t white_king;
+    uint8_t black_king;
+    uint8_t pawn;
+    Result result;
+  };
+
+  static constexpr size_t kNorth = kNumFiles;
+
+  KpkBitbase() {
+    std::vector<Entry> entries;
+    entries.reserve(kKpkSize);
+    for (size_t i = 0; i < kKpkSize; ++i) entries.push_back(classify(i));
+
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (auto& entry : entries) {
+        if (entry.result != kUnknown) continue;
+        entry.result = classify(entry, entries);
+        changed |= entry.result != kUnknown;
+      }
+    }
+
+    for (size_t i = 0; i < kKpkSize; ++i) {
+      if (entries.at(i).result == kWin) {
+        wins_.at(i / 64) |= uint64_t{1} << (i % 64);
+      }
+    }
+  }
+
+  static auto classify(size_t i) -> Entry {
+    Entry entry{
+        .active_color =
+            ((i >> 12U) & 1U) != 0 ? Color::kBlack : Color::kWhite,
+        .white_king = static_cast<uint8_t>(i & 63U),
+        .black_king = static_cast<uint8_t>((i >> 6U) & 63U),
+        .pawn = static_cast<uint8_t>(
+            (((i >> 13U) / kKpkPawnFiles + 1) * kNumFiles) +
+            ((i >> 13U) % kKpkPawnFiles)),
+        .result = kUnknown,
+    };
+    auto white_king_attacks = kingAttacks(entry.white_king);
+    auto black_king_attacks = kingAttacks(entry.black_king);
+    auto pawn_attacks = pawnAttacks(Color::kWhite, entry.pawn);
+    size_t const promotion = entry.pawn - kNorth;
+
+    if ((white_king_attacks & squareBit(entry.black_king)) != 0 ||
+        entry.white_king == entry.black_king ||
+        entry.pawn == entry.white_king || entry.pawn == entry.black_king ||
+        (entry.active_color == Color::kWhite &&
+         (pawn_attacks & squareBit(entry.black_king)) != 0)) {
+      entry.result = kInvalid;
+    } else if (entry.active_color == Color::kWhite && entry.pawn < 2 * kNorth &&
+               promotion != entry.white_king &&
+               promotion != entry.black_king &&
+               ((black_king_attacks & squareBit(promotion)) == 0 ||
+                (white_king_attacks & squareBit(promotion)) != 0)) {
+      entry.result = kWin;
+    } else if (entry.active_color == Color::kBlack &&
+               ((black_king_attacks &
+                 ~(white_king_attacks | pawn_attacks)) == 0 ||
+                (black_king_attacks & ~white_king_attacks &
+                 squareBit(entry.pawn)) != 0)) {
+      entry.result = kDraw;
+    }
+    return entry;
+  }
+
+  static auto classify(const Entry& entry, const std::vector<Entry>& entries)
+      -> Result {
+    bool const white = entry.active_color == Color::kWhite;
+    auto them = white ? Color::kBlack : Color::kWhite;
+    auto result_of = [&](size_t white_king, size_t black_king, size_t pawn) {
+      return entries.at(kpkIndex(them, white_king, black_king, pawn)).result;
+    };
+
+    uint8_t successors = kInvalid;
+    size_t const king = white ? entry.white_king : entry.black_king;
+    for (auto moves = kingAttacks(king); moves != 0;) {
+      auto to = popLsb(moves);
+      successors |= white ? result_of(to, entry.black_king, entry.pawn)
+                          : result_of(entry.white_king, to, entry.pawn);
+    }
+
+    // Pushes to an occupied square lead to invalid positions, which add
+    // nothing. Promotions were classified on their own.
+    if (white && entry.pawn >= 2 * kNorth) {
+      size_t const push = entry.pawn - kNorth;
+      successors |= result_of(entry.white_king, entry.black_king, push);
+      if (entry.pawn >= 6 * kNorth && push != entry.white_king &&
+          push != entry.black_king) {
+        successors |=
+            result_of(entry.white_king, entry.black_king, push - kNorth);
+      }
+    }
+
+    auto good = white ? kWin : kDraw;
+    auto bad = white ? kDraw : kWin;
+    if ((successors & good) != 0) return good;
+    if ((successors & kUnknown) != 0) return kUnknown;
+    return bad;
+  }
+
+  std::array<uint64_t, kKpkSize / 64> wins_{};
+};
+
+}  // namespace chesscxx::internal
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_ENDGAME_INTERNAL_KPK_BITBASE_H_
@@ -0,0 +1,75 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_ENDGAME_INTERNAL_LONE_PIECE_ENDGAME_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_ENDGAME_INTERNAL_LONE_PIECE_ENDGAME_H_
+
+#include <bit>
+#include <cstddef>
+#include <optional>
+
+#include "../../color.h"
+#include "../../core/internal/bitboard.h"
+#include "../../core/internal/piece_placement_bitboards.h"
+#include "../../core/internal/position.h"
+#include "../../piece_type.h"
+#include "../../position.h"
+#include "../bitbase_result.h"
+
+namespace chesscxx::internal {
+
+// The squares of the two kings and of the only other piece, if the position
+// holds nothing else and that piece is of the given type.
+struct LonePieceSquares {
+  Color strong_side;
+  size_t strong_king;
+  size_t weak_king;
+  size_t piece;
+};
+
+inline auto lonePieceSquares(const Position& position, const PieceType& type)
+    -> std::optional<LonePieceSquares> {
+  using Bitboards = PiecePlacementBitboards;
+  const auto& piece_placement = position.piecePlacement();
+
+  auto pieces = Bitboards::pieces(piece_placement, type);
+  if (std::popcount(Bitboards::occupancy(piece_placement)) != 3 ||
+      !isSingleBit(pieces)) {
+    return std::nullopt;
+  }
+
+  auto strong_side =
+      (Bitboards::pieces(piece_placement, Color::kWhite) & pieces) != 0
+          ? Color::kWhite
+          : Color::kBlack;
+  return LonePieceSquares{
+      .strong_side = strong_side,
+      .strong_king = lsbIndex(
+          Bitboards::pieces(piece_placement, strong_side, PieceType::kKing)),
+      .weak_king = lsbIndex(
+          Bitboards::pieces(piece_placement, !strong_side, PieceType::kKing)),
+      .piece = lsbIndex(pieces),
+  };
+}
+
+// K+R or K+Q vs K is won, unless the lone king is stalemated or takes the
+// undefended piece.
+inline auto probeMajorPiece(const Position& position, const PieceType& type)
+    -> std::optional<BitbaseResult> {
+  auto squares = lonePieceSquares(position, type);
+  if (!squares) return std::nullopt;
+  if (position.activeColor() == squares->strong_side) {
+    return BitbaseResult::kWin;
+  }
+
+  if (!hasLegalMove(position)) {
+    return isCheck(position) ? BitbaseResult::kWin : BitbaseResult::kDraw;
+  }
+  auto piece = squareBit(squares->piece);
+  if ((kingAttacks(squares->weak_king) & piece) != 0 &&
+      (kingAttacks(squares->strong_king) & piece) == 0) {
+    return BitbaseResult::kDraw;
+  }
+  return BitbaseResult::kWin;
+}
+
+}  // namespace chesscxx::internal
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_ENDGAME_INTERNAL_LONE_PIECE_ENDGAME_H_
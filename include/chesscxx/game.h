@@ -1,7 +1,8 @@
 #ifndef CHESSCXX_INCLUDE_CHESSCXX_GAME_H_
 #define CHESSCXX_INCLUDE_CHESSCXX_GAME_H_
 
-#include "core/game.h"  // IWYU pragma: export
+#include "core/game.h"                 // IWYU pragma: export
+#include "core/upcoming_repetition.h"  // IWYU pragma: export
 
 /// @defgroup GameHelpers Game helper classes
 #include "formatter/game_formatter.h"  // IWYU pragma: export
@@ -0,0 +1,119 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_HASH_PAWN_HASH_TABLE_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_HASH_PAWN_HASH_TABLE_H_
+
+// IWYU pragma: private, include "../pawn_hash_table.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "../core/position.h"
+#include "../core/position_impl.h"  // IWYU pragma: keep
+
+namespace chesscxx {
+
+/// @defgroup PawnHashTableGroup Pawn hash table
+/// @{
+
+/// @brief A fixed-size cache of values computed from the pawn structure,
+/// indexed by Position::pawnKey().
+///
+/// Each key maps to a single slot, and storing into an occupied slot replaces
+/// its entry. The full key is kept with the entry, so a probe never returns an
+/// entry stored for a different pawn structure.
+///
+/// @tparam Entry The cached value type.
+/// @tparam kNumEntries The number of slots. Must be a power of two.
+template <typename Entry, size_t kNumEntries>
+class PawnHashTable {
+  static_assert(std::has_single_bit(kNumEntries),
+                "the number of entries must be a power of two");
+
+ public:
+  /// @name Constructors
+  /// @{
+
+  /// @brief Constructs an empty table.
+  PawnHashTable() : slots_(kNumEntries) {}
+
+  /// @}
+
+  /// @name Lookup
+  /// @{
+
+  /// @brief Returns the entry stored for the key, or nullptr if there is none.
+  auto probe(uint64_t key) -> Entry* {
+    auto& slot = slotFor(key);
+    return slot.entry && slot.key == key ? &*slot.entry : nullptr;
+  }
+  /// @brief Returns the entry stored for the key, or nullptr if there is none.
+  auto probe(uint64_t key) const -> const Entry* {
+    const auto& slot = slotFor(key);
+    return slot.entry && slot.key == key ? &*slot.entry : nullptr;
+  }
+  /// @brief Returns the entry stored for the pawn structure of the position,
+  /// or nullptr if there is none.
+  auto probe(const Position& position) -> Entry* {
+    return probe(position.pawnKey());
+  }
+  /// @brief Returns the entry stored for the pawn structure of the position,
+  /// or nullptr if there is none.
+  auto probe(const Position& position) const -> const Entry* {
+    return probe(position.pawnKey());
+  }
+
+  /// @}
+
+  /// @name Modifiers
+  /// @{
+
+  /// @brief Stores the entry for the key, replacing the one in its slot.
+  auto store(uint64_t key, Entry entry) -> Entry& {
+    auto& slot = slotFor(key);
+    slot.key = key;
+    return slot.entry.emplace(std::move(entry));
+  }
+  /// @brief Stores the entry for the pawn structure of the position, replacing
+  /// the one in its slot.
+  auto store(const Position& position, Entry entry) -> Entry& {
+    return store(position.pawnKey(), std::move(entry));
+  }
+  /// @brief Removes all entries.
+  void clear() {
+    for (auto& slot : slots_) slot.entry.reset();
+  }
+
+  /// @}
+
+  /// @name Capacity
+  /// @{
+
+  /// @brief Returns the number of slots.
+  static constexpr auto size() -> size_t { return kNumEntries; }
+
+  /// @}
+
+ private:
+  struct Slot {
+    uint64_t key = 0;
+    std::optional<Entry> entry;
+  };
+
+  auto slotFor(uint64_t key) -> Slot& {
+    return slots_[key & (kNumEntries - 1)];
+  }
+  auto slotFor(uint64_t key) const -> const Slot& {
+    return slots_[key & (kNumEntries - 1)];
+  }
+
+  std::vector<Slot> slots_;
+};
+
+/// @}
+
+}  // namespace chesscxx
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_HASH_PAWN_HASH_TABLE_H_
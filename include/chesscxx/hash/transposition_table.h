@@ -0,0 +1,290 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_HASH_TRANSPOSITION_TABLE_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_HASH_TRANSPOSITION_TABLE_H_
+
+// IWYU pragma: private, include "../transposition_table.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "../core/position.h"
+#include "../core/position_impl.h"  // IWYU pragma: keep
+
+namespace chesscxx {
+
+/// @defgroup TranspositionTableGroup Transposition table
+/// @{
+
+/// @brief A fixed-size table of search results keyed by Position::zobristKey(),
+/// which threads may probe and store into concurrently without locks.
+///
+/// Entries are grouped in cache-line-sized buckets, so a probe reads a single
+/// cache line. Every slot keeps its full key XORed with its entry: a slot
+/// another thread is halfway through writing no longer matches its key, so a
+/// probe misses instead of returning a torn entry.
+///
+/// When a bucket is full, a store replaces the entry of the oldest search, as
+/// counted by newSearch(). Among entries of the same age, those with the
+/// lowest `depth` member, if Entry has one, go first.
+///
+/// @tparam Entry The stored value type. It must be trivially copyable and at
+/// most 55 bytes. Each slot adds a generation byte after the entry, so an
+/// entry whose size is a multiple of eight bytes takes one more word.
+template <typename Entry>
+class TranspositionTable {
+  static_assert(std::is_trivially_copyable_v<Entry>,
+                "entries are copied word by word");
+  static_assert(sizeof(Entry) <= 55,
+                "an entry, its generation and its key must fit a bucket");
+
+ public:
+  /// @brief Size of a bucket, in bytes.
+  static constexpr size_t kBucketSize = 64;
+
+ private:
+  static constexpr size_t kNumDataWords = (sizeof(Entry) + 1 + 7) / 8;
+  static constexpr size_t kSlotSize = (kNumDataWords + 1) * 8;
+
+ public:
+  /// @brief Number of entries sharing a bucket.
+  static constexpr size_t kEntriesPerBucket = kBucketSize / kSlotSize;
+
+  /// @name Constructors
+  /// @{
+
+  /// @brief Constructs an empty table using at most the given number of bytes,
+  /// rounded down to a power of two number of buckets, with at least one.
+  /// @param num_bytes The memory budget of the table.
+  /// @param use_huge_pages Whether to ask the operating system to back the
+  /// table with huge pages, which spares TLB misses on large tables. The hint
+  /// is ignored where it is not supported.
+  explicit TranspositionTable(size_t num_bytes, bool use_huge_pages = false)
+      : num_buckets_(std::bit_floor(std::max<size_t>(
+            num_bytes / kBucketSize, 1))) {
+    auto alignment = use_huge_pages ? kHugePageSize : kBucketSize;
+    auto size = std::max(numBytes(), alignment);
+    auto* memory = static_cast<Bucket*>(std::aligned_alloc(alignment, size));
+    if (memory == nullptr) throw std::bad_alloc();
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (use_huge_pages) madvise(memory, size, MADV_HUGEPAGE);
+#endif
+
+    std::uninitialized_value_construct_n(memory, num_buckets_);
+    buckets_.reset(memory);
+  }
+
+  /// @}
+
+  /// @name Lookup
+  /// @{
+
+  /// @brief Returns the entry stored for the key, if any.
+  auto probe(uint64_t key) const -> std::optional<Entry> {
+    const auto& bucket = bucketFor(key);
+    for (const auto& slot : bucket.slots) {
+      auto words = load(slot);
+      if (generationOf(words) != 0 && matches(words, key)) {
+        return toEntry(words);
+      }
+    }
+    return std::nullopt;
+  }
+  /// @brief Returns the entry stored for the position, if any.
+  auto probe(const Position& position) const -> std::optional<Entry> {
+    return probe(position.zobristKey());
+  }
+
+  /// @brief Asks the processor to start loading the bucket of the key, so a
+  /// probe made a little later finds it in cache.
+  void prefetch(uint64_t key) const {
+#if defined(__GNUC__)
+    __builtin_prefetch(&bucketFor(key));
+#else
+    static_cast<void>(key);
+#endif
+  }
+
+  /// @}
+
+  /// @name Modifiers
+  /// @{
+
+  /// @brief Stores the entry for the key. It replaces the entry already
+  /// stored for the key, or else an empty slot, or else the least valuable
+  /// entry of the bucket.
+  void store(uint64_t key, const Entry& entry) {
+    auto& bucket = bucketFor(key);
+    auto* victim = &bucket.slots.front();
+    auto victim_score = std::numeric_limits<int>::max();
+
+    for (auto& slot : bucket.slots) {
+      auto words = load(slot);
+      if (generationOf(words) == 0 || matches(words, key)) {
+        victim = &slot;
+        break;
+      }
+
+      auto score = replacementScore(words);
+      if (score < victim_score) {
+        victim = &slot;
+        victim_score = score;
+      }
+    }
+
+    save(*victim, key, entry);
+  }
+  /// @brief Stores the entry for the position.
+  void store(const Position& position, const Entry& entry) {
+    store(position.zobristKey(), entry);
+  }
+
+  /// @brief Starts a new search: entries stored from now on are younger than
+  /// all the entries already stored, which become the first to be replaced.
+  void newSearch() {
+    generation_ = generation_ == kMaxGeneration ? 1 : generation_ + 1;
+  }
+
+  /// @brief Removes all entries. Must not run while other threads use the
+  /// table.
+  void clear() {
+    for (size_t i = 0; i < num_buckets_; ++i) {
+      for (auto& slot : buckets_[i].slots) {
+        for (auto& word : slot) word.store(0, std::memory_order_relaxed);
+      }
+    }
+    generation_ = 1;
+  }
+
+  /// @}
+
+  /// @name Capacity
+  /// @{
+
+  /// @brief Returns the number of buckets.
+  auto numBuckets() const -> size_t { return num_buckets_; }
+  /// @brief Returns the number of entries the table can hold.
+  auto numEntries() const -> size_t {
+    return num_buckets_ * kEntriesPerBucket;
+  }
+  /// @brief Returns the memory used by the entries, in bytes.
+  auto numBytes() const -> size_t { return num_buckets_ * kBucketSize; }
+
+  /// @brief Returns the share of slots, in permille, holding an entry of the
+  /// current search, estimated from the first thousand buckets at most. This
+  /// is what the UCI `hashfull` info reports.
+  auto hashfull() const -> int {
+    auto num_sampled = std::min<size_t>(num_buckets_, 1000);
+    size_t used = 0;
+    for (size_t i = 0; i < num_sampled; ++i) {
+      for (const auto& slot : buckets_[i].slots) {
+        if (generationOf(load(slot)) == generation_) ++used;
+      }
+    }
+    return static_cast<int>(used * 1000 / (num_sampled * kEntriesPerBucket));
+  }
+
+  /// @}
+
+ private:
+  // The first word holds the key XORed with the data words. These hold the
+  // entry's bytes, then the generation byte. Generation 0 marks an empty slot.
+  using Slot = std::array<std::atomic<uint64_t>, kNumDataWords + 1>;
+  using Words = std::array<uint64_t, kNumDataWords + 1>;
+  using Bytes = std::array<std::byte, sizeof(Words)>;
+
+  struct alignas(kBucketSize) Bucket {
+    std::array<Slot, kEntriesPerBucket> slots;
+  };
+
+  struct FreeDeleter {
+    void operator()(Bucket* buckets) const { std::free(buckets); }
+  };
+
+  static constexpr size_t kHugePageSize = size_t{2} << 20U;
+  static constexpr size_t kGenerationByte = sizeof(uint64_t) + sizeof(Entry);
+  static constexpr uint8_t kMaxGeneration = 0xFF;
+
+  static auto load(const Slot& slot) -> Words {
+    Words words{};
+    for (size_t i = 0; i < words.size(); ++i) {
+      words.at(i) = slot.at(i).load(std::memory_order_relaxed);
+    }
+    return words;
+  }
+
+  static auto foldData(const Words& words) -> uint64_t {
+    uint64_t folded = 0;
+    for (size_t i = 1; i < words.size(); ++i) folded ^= words.at(i);
+    return folded;
+  }
+
+  static auto generationOf(const Words& words) -> uint8_t {
+    return std::to_integer<uint8_t>(
+        std::bit_cast<Bytes>(words).at(kGenerationByte));
+  }
+
+  static auto matches(const Words& words, uint64_t key) -> bool {
+    return (words.front() ^ foldData(words)) == key;
+  }
+
+  static auto toEntry(const Words& words) -> Entry {
+    std::array<std::byte, sizeof(Entry)> bytes{};
+    std::memcpy(bytes.data(), &words.at(1), sizeof(Entry));
+    return std::bit_cast<Entry>(bytes);
+  }
+
+  // Lower scores are replaced first.
+  auto replacementScore(const Words& words) const -> int {
+    int const age =
+        (generation_ - generationOf(words) + kMaxGeneration) % kMaxGeneration;
+    int depth = 0;
+    if constexpr (requires(const Entry& entry) { entry.depth; }) {
+      depth = static_cast<int>(toEntry(words).depth);
+    }
+    return depth - (age * kMaxGeneration);
+  }
+
+  void save(Slot& slot, uint64_t key, const Entry& entry) const {
+    Bytes bytes{};
+    std::memcpy(&bytes.at(sizeof(uint64_t)), &entry, sizeof(Entry));
+    bytes.at(kGenerationByte) = std::byte{generation_};
+    auto words = std::bit_cast<Words>(bytes);
+    words.front() = key ^ foldData(words);
+
+    for (size_t i = 0; i < words.size(); ++i) {
+      slot.at(i).store(words.at(i), std::memory_order_relaxed);
+    }
+  }
+
+  auto bucketFor(uint64_t key) const -> const Bucket& {
+    return buckets_[key & (num_buckets_ - 1)];
+  }
+  auto bucketFor(uint64_t key) -> Bucket& {
+    return buckets_[key & (num_buckets_ - 1)];
+  }
+
+  size_t num_buckets_;
+  std::unique_ptr<Bucket[], FreeDeleter> buckets_;
+  uint8_t generation_ = 1;
+};
+
+/// @}
+
+}  // namespace chesscxx
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_HASH_TRANSPOSITION_TABLE_H_
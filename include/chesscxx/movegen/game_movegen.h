@@ -1,13 +1,26 @@
 #ifndef CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_GAME_MOVEGEN_H_
 #define CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_GAME_MOVEGEN_H_
 
+#include <cstddef>
 #include <generator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
 
+#include "../core/internal/position_check.h"
+#include "../core/internal/position_legality.h"
 #include "../game.h"
+#include "../position.h"
 #include "../san_move.h"
+#include "../stats.h"
 #include "../uci_move.h"
+#include "gen_type.h"
+#include "internal/position_gen_type_movegen.h"
 #include "internal/position_movegen.h"
 #include "internal/position_san_movegen.h"
+#include "internal/position_see.h"
+#include "internal/position_staged_movegen.h"
 
 namespace chesscxx {
 
@@ -23,6 +36,35 @@ inline auto legalUciMoves(const Game& game) -> std::generator<UciMove> {
   return internal::legalMoves(game.currentPosition());
 }
 
+/// @brief Generates all legal moves in UCI (Universal Chess Interface) format
+/// from the current position in the given game, allocating every coroutine
+/// frame from the given memory resource.
+/// @param game The game whose current position is used to generate moves.
+/// @param resource The memory resource used for coroutine frames. It must
+/// outlive the returned generator.
+/// @return A generator yielding legal moves in UCI format.
+/// @note The moves are not guaranteed to be generated in any specific order.
+inline auto legalUciMoves(const Game& game, std::pmr::memory_resource* resource)
+    -> std::generator<UciMove> {
+  return internal::legalMoves(
+      std::allocator_arg,
+      internal::statsAllocator(std::pmr::polymorphic_allocator<>(resource)),
+      game.currentPosition());
+}
+
+/// @brief Generates the legal moves of the given type in UCI (Universal Chess
+/// Interface) format from the current position in the given game.
+/// @tparam Type The subset of the legal moves to generate.
+/// @param game The game whose current position is used to generate moves.
+/// @return A generator yielding legal moves in UCI format.
+/// @note The moves are not guaranteed to be generated in any specific order.
+template <GenType Type>
+inline auto legalUciMoves(const Game& game) -> std::generator<UciMove> {
+  return internal::legalMovesOfType<Type>(
+      std::allocator_arg, internal::statsAllocator(std::allocator<std::byte>{}),
+      game.currentPosition());
+}
+
 /// @brief Generates all legal moves in SAN (Standard Algebraic Notation) format
 /// from the current position in the given game.
 /// @param game The game whose current position is used to generate moves.
@@ -32,6 +74,126 @@ inline auto legalSanMoves(const Game& game) -> std::generator<SanMove> {
   return internal::legalSanMoves(game.currentPosition());
 }
 
+/// @brief Generates all legal moves in SAN (Standard Algebraic Notation) format
+/// from the current position in the given game, allocating every coroutine
+/// frame from the given memory resource.
+/// @param game The game whose current position is used to generate moves.
+/// @param resource The memory resource used for coroutine frames. It must
+/// outlive the returned generator.
+/// @return A generator yielding legal moves in SAN format.
+/// @note The moves are not guaranteed to be generated in any specific order.
+inline auto legalSanMoves(const Game& game, std::pmr::memory_resource* resource)
+    -> std::generator<SanMove> {
+  return internal::legalSanMoves(
+      std::allocator_arg,
+      internal::statsAllocator(std::pmr::polymorphic_allocator<>(resource)),
+      game.currentPosition());
+}
+
+/// @brief Generates all legal moves in UCI (Universal Chess Interface) format
+/// from the current position in the given game, in stages: captures and
+/// promotions first, then quiet moves, then castlings.
+/// @param game The game whose current position is used to generate moves.
+/// @return A generator yielding legal moves in UCI format.
+/// @note A stage is only generated once the previous one is exhausted, so a
+/// caller that stops early never pays for the later stages. The order of the
+/// moves within a stage is unspecified.
+inline auto stagedLegalUciMoves(const Game& game) -> std::generator<UciMove> {
+  return internal::stagedLegalMoves(
+      std::allocator_arg, internal::statsAllocator(std::allocator<std::byte>{}),
+      game.currentPosition());
+}
+
+/// @brief Generates all legal moves in UCI (Universal Chess Interface) format
+/// from the current position in the given game, in stages: captures and
+/// promotions first, then quiet moves, then castlings. Captures and promotions
+/// are yielded in descending order of their score.
+/// @param game The game whose current position is used to generate moves.
+/// @param scorer Called as `scorer(position, move)` once for every capture and
+/// promotion, before the move is made. mvvLvaScore() can be passed directly.
+/// @return A generator yielding legal moves in UCI format.
+/// @note Moves with equal scores, quiet moves and castlings are yielded in
+/// unspecified order.
+template <typename Scorer>
+  requires std::is_invocable_r_v<int, Scorer, const Position&, const UciMove&>
+inline auto stagedLegalUciMoves(const Game& game, Scorer scorer)
+    -> std::generator<UciMove> {
+  return internal::stagedLegalMoves(
+      std::allocator_arg, internal::statsAllocator(std::allocator<std::byte>{}),
+      game.currentPosition(), std::move(scorer));
+}
+
+/// @brief Scores a move by MVV-LVA (Most Valuable Victim, Least Valuable
+/// Attacker): the value of the captured piece, and of the promotion gain,
+/// dominates, and the value of the moving piece breaks ties.
+/// @param position The position before the move is made.
+/// @param move The move to score.
+/// @return Higher scores for more promising captures and promotions. Quiet
+/// moves of the king score zero.
+inline auto mvvLvaScore(const Position& position, const UciMove& move) -> int {
+  return internal::mvvLvaScore(position, move);
+}
+
+/// @brief Checks whether a move gives check, without making it. Direct checks
+/// are looked up among the squares from which each piece type attacks the
+/// opponent king, and discovered checks among the pieces that stand alone
+/// between that king and one of the mover's sliders.
+/// @param position The position before the move is made.
+/// @param move The move to test. It is assumed to be legal.
+/// @return True if the opponent king is in check after the move.
+inline auto givesCheck(const Position& position, const UciMove& move) -> bool {
+  return internal::givesCheck(position, move);
+}
+
+/// @brief Checks whether a move is pseudo-legal: the side to move has a piece
+/// on its origin that can reach its destination, castling rights and paths
+/// allow it, and a promotion piece is given exactly when a pawn reaches the
+/// last rank. Whether the move leaves the own king in check is not tested.
+/// @param position The position before the move is made.
+/// @param move The move to test.
+/// @return True if the move is pseudo-legal.
+inline auto isPseudoLegal(const Position& position, const UciMove& move)
+    -> bool {
+  return internal::isPseudoLegal(position, move);
+}
+
+/// @brief Checks whether a move is legal, in constant time. No move is
+/// generated or made: the move is tested against attack tables and against
+/// the pieces giving check and the pieces pinned to the king.
+/// @param position The position before the move is made.
+/// @param move The move to test.
+/// @return True if the move is legal.
+inline auto isLegal(const Position& position, const UciMove& move) -> bool {
+  return internal::isLegal(position, move);
+}
+
+/// @brief Computes the static exchange evaluation of a move: the material won
+/// or lost on the destination square once both sides have kept recapturing
+/// there with their least valuable piece for as long as it pays off.
+/// @param position The position before the move is made.
+/// @param move The move to evaluate. It is assumed to be pseudo-legal.
+/// @return The material balance for the moving side, in pawns: 1 for a pawn, 3
+/// for a knight or a bishop, 5 for a rook and 9 for a queen. Castlings and
+/// quiet moves to unattacked squares evaluate to zero.
+/// @note Pieces hidden behind a recapturing slider join the exchange, but pins
+/// and checks are ignored.
+inline auto see(const Position& position, const UciMove& move) -> int {
+  return internal::see(position, move);
+}
+
+/// @brief Checks whether the static exchange evaluation of a move is at least
+/// the given threshold. Equivalent to `see(position, move) >= threshold`, but
+/// faster, since the exchange is only followed until the outcome is known.
+/// @param position The position before the move is made.
+/// @param move The move to evaluate. It is assumed to be pseudo-legal.
+/// @param threshold The material balance to compare with, in the units of
+/// see().
+/// @return True if the exchange started by the move wins at least `threshold`.
+inline auto seeGreaterOrEqual(const Position& position, const UciMove& move,
+                              int threshold) -> bool {
+  return internal::seeGreaterOrEqual(position, move, threshold);
+}
+
 /// @}
 
 }  // namespace chesscxx
@@ -0,0 +1,27 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_GEN_TYPE_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_GEN_TYPE_H_
+
+// IWYU pragma: private, include "../movegen.h"
+
+#include <cstdint>
+
+namespace chesscxx {
+
+/// @brief Selects which subset of the legal moves a generator produces.
+enum class GenType : uint8_t {
+  /// @brief Every legal move.
+  kAll,
+  /// @brief Captures, including en passant captures, and promotions.
+  kCaptures,
+  /// @brief Every legal move that is not in kCaptures, including castlings.
+  kQuiets,
+  /// @brief Every legal move when the side to move is in check, and no move
+  /// otherwise.
+  kEvasions,
+  /// @brief The moves in kQuiets that give check.
+  kQuietChecks,
+};
+
+}  // namespace chesscxx
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_GEN_TYPE_H_
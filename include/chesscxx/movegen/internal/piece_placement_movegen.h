@@ -1,8 +1,10 @@
 #ifndef CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_INTERNAL_PIECE_PLACEMENT_MOVEGEN_H_
 #define CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_INTERNAL_PIECE_PLACEMENT_MOVEGEN_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <generator>
+#include <memory>
 #include <optional>
 #include <ranges>
 #include <utility>
@@ -13,6 +15,7 @@
 #include "../../piece_placement.h"
 #include "../../piece_type.h"
 #include "../../square.h"
+#include "../../stats.h"
 #include "square_movegen.h"
 
 namespace chesscxx::internal {
@@ -81,29 +84,46 @@ inline auto firstMatchingPieceInEachRange(
   });
 }
 
-inline auto pseudoLegalKnightMoves(PiecePlacement piece_placement,
+template <typename Allocator>
+inline auto pseudoLegalKnightMoves(std::allocator_arg_t /*tag*/,
+                                   Allocator alloc,
+                                   PiecePlacement piece_placement,
                                    Square square, Color color)
     -> std::generator<Square> {
-  co_yield std::ranges::elements_of(knightMoves(square) |
-                                    squaresWithout(piece_placement, color));
+  co_yield std::ranges::elements_of(
+      knightMoves(std::allocator_arg, alloc, square) |
+          squaresWithout(piece_placement, color),
+      alloc);
 }
 
-inline auto pseudoLegalKingMoves(PiecePlacement piece_placement, Square square,
+template <typename Allocator>
+inline auto pseudoLegalKingMoves(std::allocator_arg_t /*tag*/,
+                                 Allocator alloc,
+                                 PiecePlacement piece_placement, Square square,
                                  Color color) -> std::generator<Square> {
-  co_yield std::ranges::elements_of(kingMoves(square) |
-                                    squaresWithout(piece_placement, color));
+  co_yield std::ranges::elements_of(
+      kingMoves(std::allocator_arg, alloc, square) |
+          squaresWithout(piece_placement, color),
+      alloc);
 }
 
-inline auto pseudoLegalPawnPushs(PiecePlacement piece_placement, Square origin,
-                                 Color color) -> std::generator<Square> {
+template <Color Us, typename Allocator>
+inline auto pseudoLegalPawnPushs(std::allocator_arg_t /*tag*/,
+                                 Allocator alloc,
+                                 PiecePlacement piece_placement, Square origin)
+    -> std::generator<Square> {
   co_yield std::ranges::elements_of(
-      pawnSlidingMove(origin, color) |
-      std::views::take_while([piece_placement](const Square& destination) {
-        return !hasPieceAt(piece_placement, destination);
-      }));
+      pawnSlidingMove<Us>(std::allocator_arg, alloc, origin) |
+          std::views::take_while([piece_placement](const Square& destination) {
+            return !hasPieceAt(piece_placement, destination);
+          }),
+      alloc);
 }
 
-inline auto takeWhileEmptyOrCapture(std::generator<Square> gen,
+template <typename Allocator>
+inline auto takeWhileEmptyOrCapture(std::allocator_arg_t /*tag*/,
+                                    Allocator /*alloc*/,
+                                    std::generator<Square> gen,
                                     PiecePlacement piece_placement, Color color)
     -> std::generator<Square> {
   for (auto square : std::move(gen)) {
@@ -117,137 +137,195 @@ inline auto takeWhileEmptyOrCapture(std::generator<Square> gen,
   }
 }
 
-inline auto pseudoLegalRookMoves(PiecePlacement piece_placement, Square square,
+template <typename Allocator>
+inline auto takeEachWhileEmptyOrCapture(Allocator alloc,
+                                        PiecePlacement piece_placement,
+                                        Color color) {
+  return std::views::transform(
+      [alloc, piece_placement, color](std::generator<Square> sliding_move) {
+        return takeWhileEmptyOrCapture(std::allocator_arg, alloc,
+                                       std::move(sliding_move),
+                                       piece_placement, color);
+      });
+}
+
+template <typename Allocator>
+inline auto pseudoLegalRookMoves(std::allocator_arg_t /*tag*/,
+                                 Allocator alloc,
+                                 PiecePlacement piece_placement, Square square,
                                  Color color) -> std::generator<Square> {
   co_yield std::ranges::elements_of(
-      rookSlidingMoves(square) |
-      std::views::transform(
-          [piece_placement, color](std::generator<Square> sliding_move) {
-            return takeWhileEmptyOrCapture(std::move(sliding_move),
-                                           piece_placement, color);
-          }) |
-      std::views::join);
+      rookSlidingMoves(std::allocator_arg, alloc, square) |
+          takeEachWhileEmptyOrCapture(alloc, piece_placement, color) |
+          std::views::join,
+      alloc);
 }
 
-inline auto pseudoLegalBishopMoves(PiecePlacement piece_placement,
+template <typename Allocator>
+inline auto pseudoLegalBishopMoves(std::allocator_arg_t /*tag*/,
+                                   Allocator alloc,
+                                   PiecePlacement piece_placement,
                                    Square square, Color color)
     -> std::generator<Square> {
   co_yield std::ranges::elements_of(
-      bishopSlidingMoves(square) |
-      std::views::transform(
-          [piece_placement, color](std::generator<Square> sliding_move) {
-            return takeWhileEmptyOrCapture(std::move(sliding_move),
-                                           piece_placement, color);
-          }) |
-      std::views::join);
+      bishopSlidingMoves(std::allocator_arg, alloc, square) |
+          takeEachWhileEmptyOrCapture(alloc, piece_placement, color) |
+          std::views::join,
+      alloc);
 }
 
-inline auto pseudoLegalQueenMoves(PiecePlacement piece_placement, Square square,
+template <typename Allocator>
+inline auto pseudoLegalQueenMoves(std::allocator_arg_t /*tag*/,
+                                  Allocator alloc,
+                                  PiecePlacement piece_placement, Square square,
                                   Color color) -> std::generator<Square> {
   co_yield std::ranges::elements_of(
-      queenSlidingMoves(square) |
-      std::views::transform(
-          [piece_placement, color](std::generator<Square> sliding_move) {
-            return takeWhileEmptyOrCapture(std::move(sliding_move),
-                                           piece_placement, color);
-          }) |
-      std::views::join);
+      queenSlidingMoves(std::allocator_arg, alloc, square) |
+          takeEachWhileEmptyOrCapture(alloc, piece_placement, color) |
+          std::views::join,
+      alloc);
 }
 
-inline auto pawnsAttacking(PiecePlacement piece_placement, Square square,
+template <typename Allocator>
+inline auto pawnsAttacking(std::allocator_arg_t /*tag*/, Allocator alloc,
+                           PiecePlacement piece_placement, Square square,
                            Color color) -> std::generator<Square> {
   co_yield std::ranges::elements_of(
-      pawnCaptures(square, !color) |
-      squaresWith(piece_placement,
-                  Piece{.type = PieceType::kPawn, .color = color}));
+      pawnCaptures(std::allocator_arg, alloc, square, !color) |
+          squaresWith(piece_placement,
+                      Piece{.type = PieceType::kPawn, .color = color}),
+      alloc);
 }
 
-inline auto pawnMovingTo(PiecePlacement piece_placement, Square square,
+template <typename Allocator>
+inline auto pawnMovingTo(std::allocator_arg_t /*tag*/, Allocator alloc,
+                         PiecePlacement piece_placement, Square square,
                          Color color) -> std::generator<Square> {
   if (hasPieceAt(piece_placement, square)) co_return;
 
   co_yield std::ranges::elements_of(
-      pawnReverseSlidingMove(square, color) |
-      firstMatchingPiece<PieceType>(
-          piece_placement, PieceSpecification<PieceType>{
-                               .spec = PieceType::kPawn, .color = color}));
+      pawnReverseSlidingMove(std::allocator_arg, alloc, square, color) |
+          firstMatchingPiece<PieceType>(
+              piece_placement, PieceSpecification<PieceType>{
+                                   .spec = PieceType::kPawn, .color = color}),
+      alloc);
 }
 
-inline auto knightsReaching(PiecePlacement piece_placement, Square square,
+template <typename Allocator>
+inline auto knightsReaching(std::allocator_arg_t /*tag*/,
+                            Allocator alloc,
+                            PiecePlacement piece_placement, Square square,
                             Color color) -> std::generator<Square> {
   co_yield std::ranges::elements_of(
-      knightMoves(square) |
-      squaresWith(piece_placement,
-                  Piece{.type = PieceType::kKnight, .color = color}));
+      knightMoves(std::allocator_arg, alloc, square) |
+          squaresWith(piece_placement,
+                      Piece{.type = PieceType::kKnight, .color = color}),
+      alloc);
 }
 
-inline auto kingsReaching(PiecePlacement piece_placement, Square square,
+template <typename Allocator>
+inline auto kingsReaching(std::allocator_arg_t /*tag*/, Allocator alloc,
+                          PiecePlacement piece_placement, Square square,
                           Color color) -> std::generator<Square> {
   co_yield std::ranges::elements_of(
-      kingMoves(square) |
-      squaresWith(piece_placement,
-                  Piece{.type = PieceType::kKing, .color = color}));
+      kingMoves(std::allocator_arg, alloc, square) |
+          squaresWith(piece_placement,
+                      Piece{.type = PieceType::kKing, .color = color}),
+      alloc);
 }
 
-inline auto orthogonalSlidersReaching(PiecePlacement piece_placement,
+template <typename Allocator>
+inline auto orthogonalSlidersReaching(std::allocator_arg_t /*tag*/,
+                                      Allocator alloc,
+                                      PiecePlacement piece_placement,
                                       Square square, Color color)
     -> std::generator<Square> {
   co_yield std::ranges::elements_of(
-      rookSlidingMoves(square) |
-      firstMatchingPieceInEachRange<SlidingDirection>(
-          piece_placement,
-          {.spec = SlidingDirection::kOrthogonal, .color = color}) |
-      std::views::join);
+      rookSlidingMoves(std::allocator_arg, alloc, square) |
+          firstMatchingPieceInEachRange<SlidingDirection>(
+              piece_placement,
+              {.spec = SlidingDirection::kOrthogonal, .color = color}) |
+          std::views::join,
+      alloc);
 }
 
-inline auto rooksReaching(PiecePlacement piece_placement, Square square,
+template <typename Allocator>
+inline auto rooksReaching(std::allocator_arg_t /*tag*/, Allocator alloc,
+                          PiecePlacement piece_placement, Square square,
                           Color color) -> std::generator<Square> {
   co_yield std::ranges::elements_of(
-      rookSlidingMoves(square) |
-      firstMatchingPieceInEachRange<PieceType>(
-          piece_placement, {.spec = PieceType::kRook, .color = color}) |
-      std::views::join);
+      rookSlidingMoves(std::allocator_arg, alloc, square) |
+          firstMatchingPieceInEachRange<PieceType>(
+              piece_placement, {.spec = PieceType::kRook, .color = color}) |
+          std::views::join,
+      alloc);
 }
 
-inline auto diagonalSlidersReaching(PiecePlacement piece_placement,
+template <typename Allocator>
+inline auto diagonalSlidersReaching(std::allocator_arg_t /*tag*/,
+                                    Allocator alloc,
+                                    PiecePlacement piece_placement,
                                     Square square, Color color)
     -> std::generator<Square> {
   co_yield std::ranges::elements_of(
-      bishopSlidingMoves(square) |
-      firstMatchingPieceInEachRange<SlidingDirection>(
-          piece_placement,
-          {.spec = SlidingDirection::kDiagonal, .color = color}) |
-      std::views::join);
+      bishopSlidingMoves(std::allocator_arg, alloc, square) |
+          firstMatchingPieceInEachRange<SlidingDirection>(
+              piece_placement,
+              {.spec = SlidingDirection::kDiagonal, .color = color}) |
+          std::views::join,
+      alloc);
 }
 
-inline auto bishopsReaching(PiecePlacement piece_placement, Square square,
+template <typename Allocator>
+inline auto bishopsReaching(std::allocator_arg_t /*tag*/,
+                            Allocator alloc,
+                            PiecePlacement piece_placement, Square square,
                             Color color) -> std::generator<Square> {
   co_yield std::ranges::elements_of(
-      bishopSlidingMoves(square) |
-      firstMatchingPieceInEachRange<PieceType>(
-          piece_placement, {.spec = PieceType::kBishop, .color = color}) |
-      std::views::join);
+      bishopSlidingMoves(std::allocator_arg, alloc, square) |
+          firstMatchingPieceInEachRange<PieceType>(
+              piece_placement, {.spec = PieceType::kBishop, .color = color}) |
+          std::views::join,
+      alloc);
 }
 
-inline auto queensReaching(PiecePlacement piece_placement, Square square,
+template <typename Allocator>
+inline auto queensReaching(std::allocator_arg_t /*tag*/, Allocator alloc,
+                           PiecePlacement piece_placement, Square square,
                            Color color) -> std::generator<Square> {
   co_yield std::ranges::elements_of(
-      queenSlidingMoves(square) |
-      firstMatchingPieceInEachRange<PieceType>(
-          piece_placement, {.spec = PieceType::kQueen, .color = color}) |
-      std::views::join);
+      queenSlidingMoves(std::allocator_arg, alloc, square) |
+          firstMatchingPieceInEachRange<PieceType>(
+              piece_placement, {.spec = PieceType::kQueen, .color = color}) |
+          std::views::join,
+      alloc);
 }
 
-inline auto piecesAttacking(PiecePlacement piece_placement, Square square,
+template <typename Allocator>
+inline auto piecesAttacking(std::allocator_arg_t /*tag*/,
+                            Allocator alloc,
+                            PiecePlacement piece_placement, Square square,
                             Color color) -> std::generator<Square> {
+  using std::allocator_arg;
   using std::ranges::elements_of;
 
-  co_yield elements_of(pawnsAttacking(piece_placement, square, color));
-  co_yield elements_of(knightsReaching(piece_placement, square, color));
-  co_yield elements_of(kingsReaching(piece_placement, square, color));
   co_yield elements_of(
-      orthogonalSlidersReaching(piece_placement, square, color));
-  co_yield elements_of(diagonalSlidersReaching(piece_placement, square, color));
+      pawnsAttacking(allocator_arg, alloc, piece_placement, square, color));
+  co_yield elements_of(
+      knightsReaching(allocator_arg, alloc, piece_placement, square, color));
+  co_yield elements_of(
+      kingsReaching(allocator_arg, alloc, piece_placement, square, color));
+  co_yield elements_of(orthogonalSlidersReaching(
+      allocator_arg, alloc, piece_placement, square, color));
+  co_yield elements_of(diagonalSlidersReaching(allocator_arg, alloc,
+                                               piece_placement, square, color));
+}
+
+inline auto piecesAttacking(PiecePlacement piece_placement, Square square,
+                            Color color) -> std::generator<Square> {
+  return piecesAttacking(std::allocator_arg,
+                         statsAllocator(std::allocator<std::byte>{}),
+                         std::move(piece_placement), square, color);
 }
 
 }  // namespace chesscxx::internal
@@ -0,0 +1,200 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_INTERNAL_POSITION_GEN_TYPE_MOVEGEN_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_INTERNAL_POSITION_GEN_TYPE_MOVEGEN_H_
+
+#include <array>
+#include <generator>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "../../castling_side.h"
+#include "../../color.h"
+#include "../../core/internal/castling_rules.h"
+#include "../../core/internal/piece_placement.h"
+#include "../../core/internal/piece_placement_piece_at.h"
+#include "../../core/internal/position_check.h"
+#include "../../core/internal/rank.h"
+#include "../../core/internal/raw_move.h"
+#include "../../core/internal/square.h"
+#include "../../piece.h"
+#include "../../piece_placement.h"
+#include "../../piece_type.h"
+#include "../../position.h"
+#include "../../square.h"
+#include "../../uci_move.h"
+#include "../gen_type.h"
+#include "piece_placement_movegen.h"
+#include "position_movegen.h"
+#include "square_movegen.h"
+
+namespace chesscxx::internal {
+
+template <Color Us>
+struct TacticalMove {
+  auto operator()(const Position& position, const RawMove& move) const
+      -> bool {
+    const auto& piece_placement = position.piecePlacement();
+    if (hasPieceAt(piece_placement, move.destination, !Us)) return true;
+
+    auto piece = pieceAt(piece_placement, move.origin);
+    if (!piece || piece->type != PieceType::kPawn) return false;
+
+    return move.destination == position.enPassantTargetSquare() ||
+           move.destination.rank == promotionRank(Us);
+  }
+};
+
+template <Color Us>
+struct QuietMove {
+  auto operator()(const Position& position, const RawMove& move) const
+      -> bool {
+    return !TacticalMove<Us>{}(position, move);
+  }
+};
+
+template <Color Us>
+struct QuietCheck {
+  CheckInfo check_info;
+
+  auto operator()(const Position& position, const RawMove& move) const
+      -> bool {
+    return QuietMove<Us>{}(position, move) &&
+           givesCheck(position, check_info,
+                      UciMove(move.origin, move.destination, std::nullopt));
+  }
+};
+
+template <Color Us, typename Allocator>
+inline auto legalCastlingUciMoves(std::allocator_arg_t /*tag*/,
+                                  Allocator alloc, Position position,
+                                  bool checks_only)
+    -> std::generator<UciMove> {
+  auto check_info = checks_only ? checkInfo(position) : CheckInfo{};
+
+  for (auto side : legalCastlings<Us>(std::allocator_arg, alloc, position)) {
+    if (checks_only && !castlingGivesCheck(position, check_info, side)) {
+      continue;
+    }
+
+    auto raw_move = castlingMoves(side, Us).king_move;
+    co_yield UciMove(raw_move.origin, raw_move.destination, std::nullopt);
+  }
+}
+
+// Generates the evasions from the checking pieces instead of filtering every
+// legal move: king moves, then, against a single checker, the moves that
+// capture it or land between it and the king.
+template <Color Us, typename Allocator>
+inline auto legalEvasions(std::allocator_arg_t /*tag*/, Allocator alloc,
+                          Position position) -> std::generator<UciMove> {
+  using std::allocator_arg;
+  using std::ranges::elements_of;
+
+  static constexpr std::array<PieceType, 5> kNonKingTypes = {
+      PieceType::kPawn, PieceType::kKnight, PieceType::kBishop,
+      PieceType::kRook, PieceType::kQueen};
+
+  const auto& piece_placement = position.piecePlacement();
+  auto king = kingLocation(piece_placement, Us);
+
+  std::optional<Square> checker;
+  bool is_double_check = false;
+  for (auto square :
+       piecesAttacking(allocator_arg, alloc, piece_placement, king, !Us)) {
+    if (checker) {
+      is_double_check = true;
+      break;
+    }
+    checker = square;
+  }
+
+  if (!checker) co_return;
+
+  for (auto destination : pseudoLegalKingMoves(allocator_arg, alloc,
+                                               piece_placement, king, Us)) {
+    if (isLegalNormalMove<Us>(position, RawMove(king, destination))) {
+      co_yield UciMove(king, destination, std::nullopt);
+    }
+  }
+
+  if (is_double_check) co_return;
+
+  for (auto target : traversedSquares(allocator_arg, alloc, *checker, king)) {
+    if (target == king) continue;
+
+    for (auto type : kNonKingTypes) {
+      for (auto origin :
+           piecesReaching(allocator_arg, alloc, position, target,
+                          Piece{.type = type, .color = Us})) {
+        RawMove const move(origin, target);
+        if (!isLegalNormalMove<Us>(position, move)) continue;
+
+        if (isPromotion<Us>(piece_placement, move)) {
+          co_yield elements_of(uciPromotions(allocator_arg, alloc, move));
+          continue;
+        }
+
+        co_yield UciMove(origin, target, std::nullopt);
+      }
+    }
+  }
+
+  // A pawn that gives check right after a double push can also be captured
+  // en passant, on a square that is not on the checking line.
+  auto en_passant_target = position.enPassantTargetSquare();
+  if (!en_passant_target ||
+      enPassantCapturedPawnSquare(*en_passant_target, Us) != checker) {
+    co_return;
+  }
+
+  for (auto origin : pawnsAttacking(allocator_arg, alloc, piece_placement,
+                                    *en_passant_target, Us)) {
+    RawMove const move(origin, *en_passant_target);
+    if (isLegalNormalMove<Us>(position, move)) {
+      co_yield UciMove(origin, *en_passant_target, std::nullopt);
+    }
+  }
+}
+
+template <GenType Type, Color Us, typename Allocator>
+inline auto legalMovesOfType(std::allocator_arg_t /*tag*/, Allocator alloc,
+                             Position position) -> std::generator<UciMove> {
+  using std::allocator_arg;
+  using std::ranges::elements_of;
+
+  if constexpr (Type == GenType::kAll) {
+    co_yield elements_of(legalMoves<Us>(allocator_arg, alloc, position));
+  } else if constexpr (Type == GenType::kCaptures) {
+    co_yield elements_of(legalNormalUciMoves<Us>(allocator_arg, alloc, position,
+                                                 TacticalMove<Us>{}));
+  } else if constexpr (Type == GenType::kQuiets) {
+    co_yield elements_of(legalNormalUciMoves<Us>(allocator_arg, alloc, position,
+                                                 QuietMove<Us>{}));
+    co_yield elements_of(
+        legalCastlingUciMoves<Us>(allocator_arg, alloc, position, false));
+  } else if constexpr (Type == GenType::kEvasions) {
+    co_yield elements_of(legalEvasions<Us>(allocator_arg, alloc, position));
+  } else {
+    static_assert(Type == GenType::kQuietChecks);
+
+    co_yield elements_of(legalNormalUciMoves<Us>(
+        allocator_arg, alloc, position, QuietCheck<Us>{checkInfo(position)}));
+    co_yield elements_of(
+        legalCastlingUciMoves<Us>(allocator_arg, alloc, position, true));
+  }
+}
+
+template <GenType Type, typename Allocator>
+inline auto legalMovesOfType(std::allocator_arg_t tag, Allocator alloc,
+                             Position position) -> std::generator<UciMove> {
+  if (position.activeColor() == Color::kWhite) {
+    return legalMovesOfType<Type, Color::kWhite>(tag, std::move(alloc),
+                                                 std::move(position));
+  }
+  return legalMovesOfType<Type, Color::kBlack>(tag, std::move(alloc),
+                                               std::move(position));
+}
+
+}  // namespace chesscxx::internal
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_INTERNAL_POSITION_GEN_TYPE_MOVEGEN_H_
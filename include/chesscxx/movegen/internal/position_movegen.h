@@ -2,7 +2,9 @@
 #define CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_INTERNAL_POSITION_MOVEGEN_H_
 
 #include <array>
+#include <cstddef>
 #include <generator>
+#include <memory>
 #include <optional>
 #include <ranges>
 #include <utility>
@@ -11,137 +13,197 @@
 #include "../../color.h"
 #include "../../core/internal/piece_placement.h"
 #include "../../core/internal/piece_placement_piece_at.h"
+#include "../../core/internal/position_legality.h"
 #include "../../core/internal/rank.h"
 #include "../../core/internal/raw_move.h"
 #include "../../core/internal/square.h"
 #include "../../piece.h"
 #include "../../piece_type.h"
 #include "../../position.h"
+#include "../../rank.h"
 #include "../../square.h"
+#include "../../stats.h"
 #include "../../uci_move.h"
 #include "piece_placement_movegen.h"
 #include "square_movegen.h"
 
 namespace chesscxx::internal {
 
-inline auto pseudoLegalPawnCaptures(Position position, Square origin,
-                                    Color color) -> std::generator<Square> {
+template <Color Us, typename Allocator>
+inline auto pseudoLegalPawnCaptures(std::allocator_arg_t /*tag*/,
+                                    Allocator alloc, Position position,
+                                    Square origin) -> std::generator<Square> {
   co_yield std::ranges::elements_of(
-      pawnCaptures(origin, color) |
-      std::views::filter([position, color](const Square& destination) {
-        return hasPieceAt(position.piecePlacement(), destination, !color) ||
-               destination == position.enPassantTargetSquare();
-      }));
+      pawnCaptures<Us>(std::allocator_arg, alloc, origin) |
+          std::views::filter([position](const Square& destination) {
+            return hasPieceAt(position.piecePlacement(), destination, !Us) ||
+                   destination == position.enPassantTargetSquare();
+          }),
+      alloc);
 }
 
-inline auto pseudoLegalPawnMoves(Position position, Square square, Color color)
-    -> std::generator<Square> {
-  co_yield std::ranges::elements_of(
-      pseudoLegalPawnPushs(position.piecePlacement(), square, color));
-  co_yield std::ranges::elements_of(
-      pseudoLegalPawnCaptures(position, square, color));
+template <Color Us, typename Allocator>
+inline auto pseudoLegalPawnMoves(std::allocator_arg_t /*tag*/,
+                                 Allocator alloc, Position position,
+                                 Square square) -> std::generator<Square> {
+  co_yield std::ranges::elements_of(pseudoLegalPawnPushs<Us>(
+      std::allocator_arg, alloc, position.piecePlacement(), square));
+  co_yield std::ranges::elements_of(pseudoLegalPawnCaptures<Us>(
+      std::allocator_arg, alloc, position, square));
 }
 
-inline auto pseudoLegalMoves(Position position, Square square)
-    -> std::generator<Square> {
+template <Color Us, typename Allocator>
+inline auto pseudoLegalMoves(std::allocator_arg_t /*tag*/,
+                             Allocator alloc, Position position,
+                             Square square) -> std::generator<Square> {
   const auto& piece_placement = position.piecePlacement();
 
   auto piece = pieceAt(piece_placement, square);
   if (!piece) co_return;
 
+  using std::allocator_arg;
   using std::ranges::elements_of;
 
   switch (piece->type) {
     case PieceType::kPawn:
       co_yield elements_of(
-          pseudoLegalPawnMoves(position, square, piece->color));
+          pseudoLegalPawnMoves<Us>(allocator_arg, alloc, position, square));
       co_return;
     case PieceType::kKnight:
-      co_yield elements_of(
-          pseudoLegalKnightMoves(piece_placement, square, piece->color));
+      co_yield elements_of(pseudoLegalKnightMoves(
+          allocator_arg, alloc, piece_placement, square, Us));
       co_return;
     case PieceType::kKing:
-      co_yield elements_of(
-          pseudoLegalKingMoves(piece_placement, square, piece->color));
+      co_yield elements_of(pseudoLegalKingMoves(allocator_arg, alloc,
+                                                piece_placement, square, Us));
       co_return;
     case PieceType::kRook:
-      co_yield elements_of(
-          pseudoLegalRookMoves(piece_placement, square, piece->color));
+      co_yield elements_of(pseudoLegalRookMoves(allocator_arg, alloc,
+                                                piece_placement, square, Us));
       co_return;
     case PieceType::kBishop:
-      co_yield elements_of(
-          pseudoLegalBishopMoves(piece_placement, square, piece->color));
+      co_yield elements_of(pseudoLegalBishopMoves(
+          allocator_arg, alloc, piece_placement, square, Us));
       co_return;
     case PieceType::kQueen:
-      co_yield elements_of(
-          pseudoLegalQueenMoves(piece_placement, square, piece->color));
+      co_yield elements_of(pseudoLegalQueenMoves(
+          allocator_arg, alloc, piece_placement, square, Us));
       co_return;
     default:
       std::unreachable();
   }
 }
 
-inline auto pseudoLegalMoves(Position position) -> std::generator<RawMove> {
+template <Color Us, typename Allocator>
+inline auto pseudoLegalMoves(std::allocator_arg_t /*tag*/,
+                             Allocator alloc, Position position)
+    -> std::generator<RawMove> {
   using std::ranges::elements_of;
 
   const auto& piece_placement = position.piecePlacement();
-  const auto& color = position.activeColor();
 
-  auto location_to_pseudo_legal_moves = [position](Square piece_location) {
-    return pseudoLegalMoves(position, piece_location) |
+  auto location_to_pseudo_legal_moves = [alloc,
+                                         position](Square piece_location) {
+    return pseudoLegalMoves<Us>(std::allocator_arg, alloc, position,
+                                piece_location) |
            std::views::transform([piece_location](const Square& destination) {
              return RawMove(piece_location, destination);
            });
   };
 
-  co_yield elements_of(piece_placement.pieceLocations().at(color) |
-                       std::views::values | std::views::join |
-                       std::views::transform(location_to_pseudo_legal_moves) |
-                       std::views::join);
+  co_yield elements_of(piece_placement.pieceLocations().at(Us) |
+                           std::views::values | std::views::join |
+                           std::views::transform(
+                               location_to_pseudo_legal_moves) |
+                           std::views::join,
+                       alloc);
 }
 
-inline auto legalRawMoves(Position position) -> std::generator<RawMove> {
+struct AnyMove {
+  constexpr auto operator()(const Position& /*position*/,
+                            const RawMove& /*move*/) const -> bool {
+    return true;
+  }
+};
+
+template <Color Us>
+inline auto isLegalNormalMove(const Position& position, const RawMove& move)
+    -> bool {
+  auto origin_piece = pieceAt(position.piecePlacement(), move.origin);
+  auto captured_pawn_square = enPassantCapturedPawnSquare(move.destination, Us);
+
+  bool const is_pawn_move = origin_piece->type == PieceType::kPawn;
+  bool const is_en_passant_capture =
+      is_pawn_move && position.enPassantTargetSquare() == move.destination &&
+      captured_pawn_square;
+
+  if (is_en_passant_capture) {
+    return !enPassantCaptureResultsInSelfCheck(
+        position.piecePlacement(), move, *captured_pawn_square, Us);
+  }
+
+  return !moveResultsInSelfCheck(position.piecePlacement(), move, Us);
+}
+
+template <Color Us>
+inline auto isPromotion(const PiecePlacement& piece_placement,
+                        const RawMove& move) -> bool {
+  static constexpr Rank kPromotionRank = promotionRank(Us);
+
+  auto piece = pieceAt(piece_placement, move.origin);
+  bool const is_pawn = piece && piece->type == PieceType::kPawn;
+  return is_pawn && move.destination.rank == kPromotionRank;
+}
+
+// Yields the legal moves accepted by `filter`. The filter runs before the
+// self-check test, so rejected moves never pay for it.
+template <Color Us, typename Allocator, typename Filter = AnyMove>
+inline auto legalRawMoves(std::allocator_arg_t /*tag*/, Allocator alloc,
+                          Position position, Filter filter = {})
+    -> std::generator<RawMove> {
   using std::ranges::elements_of;
 
+  recordStat(&stats::Counters::legal_move_generations);
+
   co_yield elements_of(
-      pseudoLegalMoves(position) |
-      std::views::filter([position](const RawMove& move) {
-        auto origin_piece = pieceAt(position.piecePlacement(), move.origin);
-        auto captured_pawn_square = enPassantCapturedPawnSquare(
-            move.destination, position.activeColor());
-
-        bool const is_pawn_move = origin_piece->type == PieceType::kPawn;
-        bool const is_en_passant_capture =
-            is_pawn_move &&
-            position.enPassantTargetSquare() == move.destination &&
-            captured_pawn_square;
-
-        if (is_en_passant_capture) {
-          return !enPassantCaptureResultsInSelfCheck(
-              position.piecePlacement(), move, *captured_pawn_square,
-              position.activeColor());
-        }
-
-        return !moveResultsInSelfCheck(position.piecePlacement(), move,
-                                       position.activeColor());
-      }));
-}
-
-inline auto legalCastlings(Position position) -> std::generator<CastlingSide> {
+      pseudoLegalMoves<Us>(std::allocator_arg, alloc, position) |
+          std::views::filter([position, filter](const RawMove& move) {
+            return filter(position, move) &&
+                   isLegalNormalMove<Us>(position, move);
+          }),
+      alloc);
+}
+
+template <typename Allocator>
+inline auto legalRawMoves(std::allocator_arg_t tag, Allocator alloc,
+                          Position position) -> std::generator<RawMove> {
+  if (position.activeColor() == Color::kWhite) {
+    return legalRawMoves<Color::kWhite>(tag, std::move(alloc),
+                                        std::move(position));
+  }
+  return legalRawMoves<Color::kBlack>(tag, std::move(alloc),
+                                      std::move(position));
+}
+
+template <Color Us, typename Allocator>
+inline auto legalCastlings(std::allocator_arg_t /*tag*/,
+                           Allocator /*alloc*/, Position position)
+    -> std::generator<CastlingSide> {
   constexpr static std::array<CastlingSide, 2> kSides = {
       CastlingSide::kKingside, CastlingSide::kQueenside};
 
-  const auto& color = position.activeColor();
-
   for (const auto& side : kSides) {
-    bool const can_castle = position.castlingRights().canCastle(side, color);
+    bool const can_castle = position.castlingRights().canCastle(side, Us);
     if (!can_castle) continue;
 
-    if (!castlingError(position.piecePlacement(), side, color)) co_yield side;
+    if (!castlingError(position.piecePlacement(), side, Us)) co_yield side;
   }
 }
 
-inline auto uciPromotions(RawMove raw_move) -> std::generator<UciMove> {
+template <typename Allocator>
+inline auto uciPromotions(std::allocator_arg_t /*tag*/,
+                          Allocator /*alloc*/, RawMove raw_move)
+    -> std::generator<UciMove> {
   constexpr static std::array<PromotablePieceType, 4> kPromotions = {
       PromotablePieceType::kKnight, PromotablePieceType::kBishop,
       PromotablePieceType::kRook, PromotablePieceType::kQueen};
@@ -151,18 +213,17 @@ inline auto uciPromotions(RawMove raw_move) -> std::generator<UciMove> {
   }
 }
 
-inline auto legalNormalUciMoves(Position position) -> std::generator<UciMove> {
+template <Color Us, typename Allocator, typename Filter = AnyMove>
+inline auto legalNormalUciMoves(std::allocator_arg_t /*tag*/,
+                                Allocator alloc, Position position,
+                                Filter filter = {})
+    -> std::generator<UciMove> {
   using std::ranges::elements_of;
 
-  for (auto raw_move : legalRawMoves(position)) {
-    auto piece = pieceAt(position.piecePlacement(), raw_move.origin);
-    bool const is_pawn = piece && piece->type == PieceType::kPawn;
-    bool const is_promotion_rank =
-        raw_move.destination.rank == promotionRank(position.activeColor());
-    bool const is_promotion = is_pawn && is_promotion_rank;
-
-    if (is_promotion) {
-      co_yield elements_of(uciPromotions(raw_move));
+  for (auto raw_move :
+       legalRawMoves<Us>(std::allocator_arg, alloc, position, filter)) {
+    if (isPromotion<Us>(position.piecePlacement(), raw_move)) {
+      co_yield elements_of(uciPromotions(std::allocator_arg, alloc, raw_move));
       continue;
     }
 
@@ -170,25 +231,43 @@ inline auto legalNormalUciMoves(Position position) -> std::generator<UciMove> {
   }
 }
 
-inline auto legalMoves(Position position) -> std::generator<UciMove> {
+template <Color Us, typename Allocator>
+inline auto legalMoves(std::allocator_arg_t /*tag*/, Allocator alloc,
+                       Position position) -> std::generator<UciMove> {
   using std::ranges::elements_of;
 
   co_yield elements_of(
-      legalCastlings(position) |
-      std::views::transform([&position](const auto& side) {
-        auto raw_move = castlingMoves(side, position.activeColor()).king_move;
-        return UciMove(raw_move.origin, raw_move.destination, std::nullopt);
-      }));
+      legalCastlings<Us>(std::allocator_arg, alloc, position) |
+          std::views::transform([](const auto& side) {
+            auto raw_move = castlingMoves(side, Us).king_move;
+            return UciMove(raw_move.origin, raw_move.destination,
+                           std::nullopt);
+          }),
+      alloc);
 
-  co_yield elements_of(legalNormalUciMoves(position));
+  co_yield elements_of(
+      legalNormalUciMoves<Us>(std::allocator_arg, alloc, position));
 }
 
-inline auto hasLegalMove(const Position& position) -> bool {
-  auto moves = legalMoves(position);
-  return moves.begin() != moves.end();
+template <typename Allocator>
+inline auto legalMoves(std::allocator_arg_t tag, Allocator alloc,
+                       Position position) -> std::generator<UciMove> {
+  if (position.activeColor() == Color::kWhite) {
+    return legalMoves<Color::kWhite>(tag, std::move(alloc),
+                                     std::move(position));
+  }
+  return legalMoves<Color::kBlack>(tag, std::move(alloc), std::move(position));
+}
+
+inline auto legalMoves(Position position) -> std::generator<UciMove> {
+  return legalMoves(std::allocator_arg,
+                    statsAllocator(std::allocator<std::byte>{}),
+                    std::move(position));
 }
 
-inline auto pawnsCapturing(Position position, Square square, Color color)
+template <typename Allocator>
+inline auto pawnsCapturing(std::allocator_arg_t /*tag*/, Allocator alloc,
+                           Position position, Square square, Color color)
     -> std::generator<Square> {
   bool const has_opponent =
       hasPieceAt(position.piecePlacement(), square, !color);
@@ -197,18 +276,23 @@ inline auto pawnsCapturing(Position position, Square square, Color color)
 
   if (!has_opponent && !is_en_passant_target) co_return;
 
-  co_yield std::ranges::elements_of(
-      pawnsAttacking(position.piecePlacement(), square, color));
+  co_yield std::ranges::elements_of(pawnsAttacking(
+      std::allocator_arg, alloc, position.piecePlacement(), square, color));
 }
 
-inline auto pawnsReaching(Position position, Square square, Color color)
+template <typename Allocator>
+inline auto pawnsReaching(std::allocator_arg_t /*tag*/, Allocator alloc,
+                          Position position, Square square, Color color)
     -> std::generator<Square> {
-  co_yield std::ranges::elements_of(pawnsCapturing(position, square, color));
   co_yield std::ranges::elements_of(
-      pawnMovingTo(position.piecePlacement(), square, color));
+      pawnsCapturing(std::allocator_arg, alloc, position, square, color));
+  co_yield std::ranges::elements_of(pawnMovingTo(
+      std::allocator_arg, alloc, position.piecePlacement(), square, color));
 }
 
-inline auto piecesReaching(Position position, Square square, Piece piece)
+template <typename Allocator>
+inline auto piecesReaching(std::allocator_arg_t /*tag*/, Allocator alloc,
+                           Position position, Square square, Piece piece)
     -> std::generator<Square> {
   const auto& piece_placement = position.piecePlacement();
 
@@ -217,35 +301,49 @@ inline auto piecesReaching(Position position, Square square, Piece piece)
     co_return;
   }
 
+  using std::allocator_arg;
   using std::ranges::elements_of;
 
   switch (piece.type) {
     case PieceType::kPawn:
-      co_yield elements_of(pawnsReaching(position, square, piece.color));
+      co_yield elements_of(
+          pawnsReaching(allocator_arg, alloc, position, square, piece.color));
       co_return;
     case PieceType::kKnight:
-      co_yield elements_of(
-          knightsReaching(piece_placement, square, piece.color));
+      co_yield elements_of(knightsReaching(allocator_arg, alloc,
+                                           piece_placement, square,
+                                           piece.color));
       co_return;
     case PieceType::kKing:
-      co_yield elements_of(kingsReaching(piece_placement, square, piece.color));
+      co_yield elements_of(kingsReaching(allocator_arg, alloc, piece_placement,
+                                         square, piece.color));
       co_return;
     case PieceType::kRook:
-      co_yield elements_of(rooksReaching(piece_placement, square, piece.color));
+      co_yield elements_of(rooksReaching(allocator_arg, alloc, piece_placement,
+                                         square, piece.color));
       co_return;
     case PieceType::kBishop:
-      co_yield elements_of(
-          bishopsReaching(piece_placement, square, piece.color));
+      co_yield elements_of(bishopsReaching(allocator_arg, alloc,
+                                           piece_placement, square,
+                                           piece.color));
       co_return;
     case PieceType::kQueen:
-      co_yield elements_of(
-          queensReaching(piece_placement, square, piece.color));
+      co_yield elements_of(queensReaching(allocator_arg, alloc,
+                                          piece_placement, square,
+                                          piece.color));
       co_return;
     default:
       std::unreachable();
   }
 }
 
+inline auto piecesReaching(Position position, Square square, Piece piece)
+    -> std::generator<Square> {
+  return piecesReaching(std::allocator_arg,
+                        statsAllocator(std::allocator<std::byte>{}),
+                        std::move(position), square, piece);
+}
+
 }  // namespace chesscxx::internal
 
 #endif  // CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_INTERNAL_POSITION_MOVEGEN_H_
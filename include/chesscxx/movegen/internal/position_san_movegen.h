@@ -1,34 +1,114 @@
 #ifndef CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_INTERNAL_POSITION_SAN_MOVEGEN_H_
 #define CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_INTERNAL_POSITION_SAN_MOVEGEN_H_
 
+#include <cstddef>
 #include <generator>
-#include <ranges>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <variant>
 
+#include "../../color.h"
+#include "../../core/internal/bitboard.h"
+#include "../../core/internal/piece_placement.h"
+#include "../../core/internal/piece_placement_bitboards.h"
+#include "../../core/internal/piece_placement_piece_at.h"
+#include "../../core/internal/position_check.h"
 #include "../../core/internal/position_modifier.h"
+#include "../../core/internal/position_origins.h"
+#include "../../partial_square.h"
+#include "../../piece.h"
+#include "../../piece_type.h"
 #include "../../position.h"
 #include "../../san_move.h"
+#include "../../stats.h"
+#include "../../uci_move.h"
 #include "position_movegen.h"
 
 namespace chesscxx::internal {
 
-inline auto legalSanMoves(Position position) -> std::generator<SanMove> {
-  using std::ranges::elements_of;
+// The part of the origin square a SAN move needs to tell the moving piece
+// apart from the other pieces of the same type legally reaching the
+// destination.
+inline auto sanOrigin(const PiecePlacement& piece_placement,
+                      const UciMove& move, const Piece& piece,
+                      bool is_capture) -> PartialSquare {
+  if (piece.type == PieceType::kPawn) {
+    if (!is_capture) return PartialSquare{};
+    return PartialSquare(move.origin.file, std::nullopt);
+  }
+
+  auto candidates =
+      pieceAttacks(piece.type, index(move.destination),
+                   PiecePlacementBitboards::occupancy(piece_placement)) &
+      PiecePlacementBitboards::pieces(piece_placement, piece.color,
+                                      piece.type);
+
+  return disambiguatingOrigin(unpinnedOrigins(piece_placement, candidates,
+                                              move.destination, piece.color) |
+                                  squareBit(move.origin),
+                              move.origin);
+}
+
+// Only a checking move can be a checkmate, so only checking moves are made,
+// to look for a legal reply.
+inline auto sanCheckIndicator(Position& position, const CheckInfo& check_info,
+                              const UciMove& move)
+    -> std::optional<CheckIndicator> {
+  if (!givesCheck(position, check_info, move)) return std::nullopt;
+
+  auto expected_record = PositionModifier::move(position, move);
+  PositionModifier::undoMove(position, *expected_record);
 
+  return std::visit([](const auto& arg) { return arg.check_indicator; },
+                    *expected_record);
+}
+
+template <Color Us, typename Allocator>
+inline auto legalSanMoves(std::allocator_arg_t /*tag*/, Allocator alloc,
+                          Position position) -> std::generator<SanMove> {
   PositionModifier::resetMoveCounters(position);
 
-  co_yield elements_of(legalMoves(position) |
-                       std::views::transform([&position](const auto& uci) {
-                         auto expected_record =
-                             PositionModifier::move(position, uci);
+  const auto& piece_placement = position.piecePlacement();
+  auto check_info = checkInfo(position);
+
+  for (auto move : legalMoves<Us>(std::allocator_arg, alloc, position)) {
+    if (auto side = castlingSideFromUci(piece_placement, move, Us)) {
+      co_yield SanCastlingMove(*side);
+      continue;
+    }
 
-                         auto san = convertTo<SanMove>(*expected_record);
+    auto piece = *pieceAt(piece_placement, move.origin);
+    bool const is_capture =
+        hasPieceAt(piece_placement, move.destination) ||
+        (piece.type == PieceType::kPawn &&
+         move.destination == position.enPassantTargetSquare());
 
-                         PositionModifier::undoMove(position, *expected_record);
+    co_yield SanNormalMove{
+        .piece_type = piece.type,
+        .origin = sanOrigin(piece_placement, move, piece, is_capture),
+        .is_capture = is_capture,
+        .destination = move.destination,
+        .promotion = move.promotion,
+        .check_indicator = sanCheckIndicator(position, check_info, move)};
+  }
+}
 
-                         return san;
-                       }));
+template <typename Allocator>
+inline auto legalSanMoves(std::allocator_arg_t tag, Allocator alloc,
+                          Position position) -> std::generator<SanMove> {
+  if (position.activeColor() == Color::kWhite) {
+    return legalSanMoves<Color::kWhite>(tag, std::move(alloc),
+                                        std::move(position));
+  }
+  return legalSanMoves<Color::kBlack>(tag, std::move(alloc),
+                                      std::move(position));
+}
 
-  co_return;
+inline auto legalSanMoves(Position position) -> std::generator<SanMove> {
+  return legalSanMoves(std::allocator_arg,
+                       statsAllocator(std::allocator<std::byte>{}),
+                       std::move(position));
 }
 
 }  // namespace chesscxx::internal
@@ -0,0 +1,241 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_INTERNAL_POSITION_SEE_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_INTERNAL_POSITION_SEE_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+#include "../../color.h"
+#include "../../core/internal/bitboard.h"
+#include "../../core/internal/piece_placement_bitboards.h"
+#include "../../core/internal/piece_placement_piece_at.h"
+#include "../../core/internal/square.h"
+#include "../../piece.h"
+#include "../../piece_placement.h"
+#include "../../piece_type.h"
+#include "../../position.h"
+#include "../../square.h"
+#include "../../uci_move.h"
+
+namespace chesscxx::internal {
+
+constexpr auto pieceValue(const PieceType& type) -> int {
+  switch (type) {
+    case PieceType::kPawn:
+      return 1;
+    case PieceType::kKnight:
+    case PieceType::kBishop:
+      return 3;
+    case PieceType::kRook:
+      return 5;
+    case PieceType::kQueen:
+      return 9;
+    case PieceType::kKing:
+      return 0;
+    default:
+      std::unreachable();
+  }
+}
+
+// The pieces left on the board during an exchange on a single square.
+class ExchangeBoard {
+ public:
+  ExchangeBoard(const PiecePlacement& piece_placement, size_t target,
+                Bitboard occupancy)
+      : piece_placement_(&piece_placement),
+        target_(target),
+        occupancy_(occupancy),
+        attackers_(attackersTo(piece_placement, target, occupancy) &
+                   occupancy) {}
+
+  auto hasAttackers(const Color& color) const -> bool {
+    return (attackers_ & Bitboards::pieces(*piece_placement_, color)) != 0;
+  }
+
+  // Removes the least valuable attacker of the given color and reveals the
+  // sliders behind it.
+  auto popLeastValuableAttacker(const Color& color)
+      -> std::optional<PieceType> {
+    static constexpr std::array<PieceType, kNumPieceTypes> kTypesByValue = {
+        PieceType::kPawn, PieceType::kKnight, PieceType::kBishop,
+        PieceType::kRook, PieceType::kQueen,  PieceType::kKing};
+
+    auto own_attackers =
+        attackers_ & Bitboards::pieces(*piece_placement_, color);
+
+    for (auto type : kTypesByValue) {
+      auto candidates =
+          own_attackers & Bitboards::pieces(*piece_placement_, type);
+      if (candidates == 0) continue;
+
+      occupancy_ ^= squareBit(lsbIndex(candidates));
+      revealXRays(type);
+      attackers_ &= occupancy_;
+      return type;
+    }
+
+    return std::nullopt;
+  }
+
+ private:
+  using Bitboards = PiecePlacementBitboards;
+
+  void revealXRays(const PieceType& type) {
+    auto queens = Bitboards::pieces(*piece_placement_, PieceType::kQueen);
+
+    if (type == PieceType::kPawn || type == PieceType::kBishop ||
+        type == PieceType::kQueen) {
+      attackers_ |=
+          bishopAttacks(target_, occupancy_) &
+          (Bitboards::pieces(*piece_placement_, PieceType::kBishop) | queens);
+    }
+
+    if (type == PieceType::kRook || type == PieceType::kQueen) {
+      attackers_ |=
+          rookAttacks(target_, occupancy_) &
+          (Bitboards::pieces(*piece_placement_, PieceType::kRook) | queens);
+    }
+  }
+
+  const PiecePlacement* piece_placement_;
+  size_t target_;
+  Bitboard occupancy_;
+  Bitboard attackers_;
+};
+
+// The material won by the move itself and the value of the piece left on the
+// destination square, which is the next one to be captured.
+struct ExchangeStart {
+  int captured_value;
+  int moved_value;
+};
+
+inline auto exchangeStart(const Position& position, const UciMove& move,
+                          const PieceType& mover) -> ExchangeStart {
+  const auto& piece_placement = position.piecePlacement();
+
+  ExchangeStart start{.captured_value = 0, .moved_value = pieceValue(mover)};
+  if (auto victim = pieceAt(piece_placement, move.destination)) {
+    start.captured_value = pieceValue(victim->type);
+  } else if (mover == PieceType::kPawn &&
+             move.destination == position.enPassantTargetSquare()) {
+    start.captured_value = pieceValue(PieceType::kPawn);
+  }
+
+  if (move.promotion) {
+    auto promoted_value = pieceValue(toPieceType(*move.promotion));
+    start.captured_value += promoted_value - pieceValue(PieceType::kPawn);
+    start.moved_value = promoted_value;
+  }
+
+  return start;
+}
+
+inline auto isCastlingMove(const UciMove& move, const PieceType& mover)
+    -> bool {
+  auto file_distance = static_cast<int>(move.destination.file) -
+                       static_cast<int>(move.origin.file);
+  return mover == PieceType::kKing && (file_distance > 1 || file_distance < -1);
+}
+
+// Occupancy right after the move, with an en passant captured pawn removed.
+inline auto occupancyAfter(const Position& position, const UciMove& move,
+                           const Piece& mover) -> Bitboard {
+  const auto& piece_placement = position.piecePlacement();
+  auto occupancy = PiecePlacementBitboards::occupancy(piece_placement) &
+                   ~squareBit(move.origin);
+
+  if (mover.type == PieceType::kPawn &&
+      move.destination == position.enPassantTargetSquare()) {
+    if (auto captured_pawn_square =
+            enPassantCapturedPawnSquare(move.destination, mover.color)) {
+      occupancy &= ~squareBit(*captured_pawn_square);
+    }
+  }
+
+  return occupancy;
+}
+
+// Swap-list evaluation: both sides keep recapturing with their least valuable
+// attacker, and each may stop when going on would lose material. A king only
+// recaptures when the other side has no attackers left. Pins are ignored.
+inline auto see(const Position& position, const UciMove& move) -> int {
+  static constexpr size_t kMaxExchangeLength = 32;
+
+  const auto& piece_placement = position.piecePlacement();
+  auto mover = pieceAt(piece_placement, move.origin);
+  if (!mover || isCastlingMove(move, mover->type)) return 0;
+
+  auto start = exchangeStart(position, move, mover->type);
+  ExchangeBoard board(piece_placement, index(move.destination),
+                      occupancyAfter(position, move, *mover));
+
+  std::array<int, kMaxExchangeLength> gains{};
+  gains.at(0) = start.captured_value;
+  auto next_victim_value = start.moved_value;
+  auto side = !mover->color;
+  size_t depth = 0;
+
+  while (depth + 1 < kMaxExchangeLength) {
+    auto attacker = board.popLeastValuableAttacker(side);
+    if (!attacker) break;
+
+    if (*attacker == PieceType::kKing && board.hasAttackers(!side)) break;
+
+    ++depth;
+    gains.at(depth) = next_victim_value - gains.at(depth - 1);
+    next_victim_value = pieceValue(*attacker);
+    side = !side;
+  }
+
+  for (; depth > 0; --depth) {
+    gains.at(depth - 1) = -std::max(-gains.at(depth - 1), gains.at(depth));
+  }
+
+  return gains.at(0);
+}
+
+// Same result as see() >= threshold, but stops as soon as the outcome of the
+// exchange relative to the threshold is known.
+inline auto seeGreaterOrEqual(const Position& position, const UciMove& move,
+                              int threshold) -> bool {
+  const auto& piece_placement = position.piecePlacement();
+  auto mover = pieceAt(piece_placement, move.origin);
+  if (!mover || isCastlingMove(move, mover->type)) return threshold <= 0;
+
+  auto start = exchangeStart(position, move, mover->type);
+
+  // Balance of the exchange relative to the threshold, from the point of view
+  // of the side that just captured, if the other side stops now.
+  auto balance = start.captured_value - threshold;
+  if (balance < 0) return false;
+
+  balance = start.moved_value - balance;
+  if (balance <= 0) return true;
+
+  ExchangeBoard board(piece_placement, index(move.destination),
+                      occupancyAfter(position, move, *mover));
+
+  bool mover_wins = true;
+  auto side = !mover->color;
+
+  while (auto attacker = board.popLeastValuableAttacker(side)) {
+    if (*attacker == PieceType::kKing) {
+      return board.hasAttackers(!side) ? mover_wins : !mover_wins;
+    }
+
+    mover_wins = !mover_wins;
+    balance = pieceValue(*attacker) - balance;
+    if (balance < static_cast<int>(mover_wins)) break;
+
+    side = !side;
+  }
+
+  return mover_wins;
+}
+
+}  // namespace chesscxx::internal
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_INTERNAL_POSITION_SEE_H_
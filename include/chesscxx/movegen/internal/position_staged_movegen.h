@@ -0,0 +1,115 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_INTERNAL_POSITION_STAGED_MOVEGEN_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_INTERNAL_POSITION_STAGED_MOVEGEN_H_
+
+#include <algorithm>
+#include <generator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../../color.h"
+#include "../../core/internal/piece_placement_piece_at.h"
+#include "../../piece_type.h"
+#include "../../position.h"
+#include "../../uci_move.h"
+#include "position_gen_type_movegen.h"
+#include "position_movegen.h"
+#include "position_see.h"
+
+namespace chesscxx::internal {
+
+struct Unscored {};
+
+inline auto mvvLvaScore(const Position& position, const UciMove& move) -> int {
+  static constexpr int kVictimWeight = 16;
+
+  const auto& piece_placement = position.piecePlacement();
+  auto attacker = pieceAt(piece_placement, move.origin);
+  auto victim = pieceAt(piece_placement, move.destination);
+
+  bool const is_en_passant_capture =
+      attacker && attacker->type == PieceType::kPawn &&
+      move.destination == position.enPassantTargetSquare();
+
+  int score = 0;
+  if (victim) {
+    score += kVictimWeight * pieceValue(victim->type);
+  } else if (is_en_passant_capture) {
+    score += kVictimWeight * pieceValue(PieceType::kPawn);
+  }
+
+  if (move.promotion) {
+    score += kVictimWeight * (pieceValue(toPieceType(*move.promotion)) -
+                              pieceValue(PieceType::kPawn));
+  }
+
+  if (attacker) score -= pieceValue(attacker->type);
+
+  return score;
+}
+
+template <Color Us, typename Allocator, typename Scorer>
+inline auto tacticalMoves(std::allocator_arg_t /*tag*/, Allocator alloc,
+                          Position position, Scorer scorer)
+    -> std::generator<UciMove> {
+  using std::ranges::elements_of;
+
+  auto moves = legalNormalUciMoves<Us>(std::allocator_arg, alloc, position,
+                                       TacticalMove<Us>{});
+
+  if constexpr (std::is_same_v<Scorer, Unscored>) {
+    co_yield elements_of(std::move(moves));
+  } else {
+    using ScoredMove = std::pair<int, UciMove>;
+    using ScoredMoveAllocator = typename std::allocator_traits<
+        Allocator>::template rebind_alloc<ScoredMove>;
+
+    std::vector<ScoredMove, ScoredMoveAllocator> scored_moves{
+        ScoredMoveAllocator(alloc)};
+
+    for (auto move : moves) {
+      scored_moves.emplace_back(scorer(position, move), move);
+    }
+
+    std::ranges::stable_sort(scored_moves, std::ranges::greater{},
+                             &ScoredMove::first);
+
+    for (const auto& scored_move : scored_moves) co_yield scored_move.second;
+  }
+}
+
+template <Color Us, typename Allocator, typename Scorer>
+inline auto stagedLegalMoves(std::allocator_arg_t /*tag*/, Allocator alloc,
+                             Position position, Scorer scorer)
+    -> std::generator<UciMove> {
+  using std::ranges::elements_of;
+
+  co_yield elements_of(tacticalMoves<Us>(std::allocator_arg, alloc, position,
+                                         std::move(scorer)));
+
+  co_yield elements_of(legalNormalUciMoves<Us>(std::allocator_arg, alloc,
+                                               position, QuietMove<Us>{}));
+
+  co_yield elements_of(legalCastlingUciMoves<Us>(std::allocator_arg, alloc,
+                                                 position, false));
+}
+
+template <typename Allocator, typename Scorer = Unscored>
+inline auto stagedLegalMoves(std::allocator_arg_t tag, Allocator alloc,
+                             Position position, Scorer scorer = {})
+    -> std::generator<UciMove> {
+  if (position.activeColor() == Color::kWhite) {
+    return stagedLegalMoves<Color::kWhite>(tag, std::move(alloc),
+                                           std::move(position),
+                                           std::move(scorer));
+  }
+  return stagedLegalMoves<Color::kBlack>(tag, std::move(alloc),
+                                         std::move(position),
+                                         std::move(scorer));
+}
+
+}  // namespace chesscxx::internal
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_MOVEGEN_INTERNAL_POSITION_STAGED_MOVEGEN_H_
@@ -4,8 +4,10 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <generator>
+#include <memory>
 #include <optional>
 #include <ranges>
 #include <utility>
@@ -15,6 +17,7 @@
 #include "../../file.h"
 #include "../../rank.h"
 #include "../../square.h"
+#include "../../stats.h"
 
 namespace chesscxx::internal {
 
@@ -72,7 +75,10 @@ inline auto slidingIncrement(const SquareOffset& offset)
                       .rank_offset = std::clamp(offset.rank_offset, kLo, kHi)};
 }
 
-inline auto traversedSquares(Square origin, Square destination,
+template <typename Allocator>
+inline auto traversedSquares(std::allocator_arg_t /*tag*/,
+                             Allocator /*alloc*/, Square origin,
+                             Square destination,
                              Origin origin_policy = Origin::kKeep)
     -> std::generator<Square> {
   if (origin_policy == Origin::kSkip && origin == destination) co_return;
@@ -94,15 +100,27 @@ inline auto traversedSquares(Square origin, Square destination,
   co_yield destination;
 }
 
-inline auto fileNeighbors(Square square) -> std::generator<Square> {
+inline auto traversedSquares(Square origin, Square destination,
+                             Origin origin_policy = Origin::kKeep)
+    -> std::generator<Square> {
+  return traversedSquares(std::allocator_arg,
+                          statsAllocator(std::allocator<std::byte>{}), origin,
+                          destination, origin_policy);
+}
+
+template <typename Allocator>
+inline auto fileNeighbors(std::allocator_arg_t /*tag*/, Allocator alloc,
+                          Square square) -> std::generator<Square> {
   static constexpr std::array<SquareOffset, 2> kOffsets = {
       {{.file_offset = 1, .rank_offset = 0},
        {.file_offset = -1, .rank_offset = 0}}};
 
-  co_yield std::ranges::elements_of(kOffsets | validMoves(square));
+  co_yield std::ranges::elements_of(kOffsets | validMoves(square), alloc);
 }
 
-inline auto knightMoves(Square square) -> std::generator<Square> {
+template <typename Allocator>
+inline auto knightMoves(std::allocator_arg_t /*tag*/, Allocator alloc,
+                        Square square) -> std::generator<Square> {
   static constexpr std::array<SquareOffset, 8> kOffsets = {
       {{.file_offset = 2, .rank_offset = 1},
        {.file_offset = 2, .rank_offset = -1},
@@ -113,43 +131,60 @@ inline auto knightMoves(Square square) -> std::generator<Square> {
        {.file_offset = -2, .rank_offset = 1},
        {.file_offset = -2, .rank_offset = -1}}};
 
-  co_yield std::ranges::elements_of(kOffsets | validMoves(square));
+  co_yield std::ranges::elements_of(kOffsets | validMoves(square), alloc);
 }
 
-inline auto pawnCaptures(Square square, Color color) -> std::generator<Square> {
-  static constexpr std::array<SquareOffset, 2> kWhiteOffsets = {
-      {{.file_offset = 1, .rank_offset = -1},
-       {.file_offset = -1, .rank_offset = -1}}};
-  static constexpr std::array<SquareOffset, 2> kBlackOffsets = {
-      {{.file_offset = 1, .rank_offset = 1},
-       {.file_offset = -1, .rank_offset = 1}}};
+template <Color Us>
+constexpr auto pawnCaptureOffsets() -> std::array<SquareOffset, 2> {
+  constexpr int kForward = (Us == Color::kWhite) ? -1 : 1;
 
-  co_yield std::ranges::elements_of(
-      ((color == Color::kWhite) ? kWhiteOffsets : kBlackOffsets) |
-      validMoves(square));
+  return {{{.file_offset = 1, .rank_offset = kForward},
+           {.file_offset = -1, .rank_offset = kForward}}};
 }
 
-inline auto pawnReverseSlidingMove(Square square, Color color)
-    -> std::generator<Square> {
+template <Color Us, typename Allocator>
+inline auto pawnCaptures(std::allocator_arg_t /*tag*/, Allocator alloc,
+                         Square square) -> std::generator<Square> {
+  static constexpr auto kOffsets = pawnCaptureOffsets<Us>();
+
+  co_yield std::ranges::elements_of(kOffsets | validMoves(square), alloc);
+}
+
+template <typename Allocator>
+inline auto pawnCaptures(std::allocator_arg_t tag, Allocator alloc,
+                         Square square, Color color) -> std::generator<Square> {
+  if (color == Color::kWhite) {
+    return pawnCaptures<Color::kWhite>(tag, std::move(alloc), square);
+  }
+  return pawnCaptures<Color::kBlack>(tag, std::move(alloc), square);
+}
+
+template <typename Allocator>
+inline auto pawnReverseSlidingMove(std::allocator_arg_t /*tag*/,
+                                   Allocator alloc, Square square,
+                                   Color color) -> std::generator<Square> {
   if (auto source = farthestPawnPushSource(square, color)) {
-    co_yield std::ranges::elements_of(
-        traversedSquares(square, *source, Origin::kSkip));
+    co_yield std::ranges::elements_of(traversedSquares(
+        std::allocator_arg, alloc, square, *source, Origin::kSkip));
   }
 
   co_return;
 }
 
-inline auto pawnSlidingMove(Square square, Color color)
-    -> std::generator<Square> {
-  if (auto destination = farthestPawnPush(square, color)) {
-    co_yield std::ranges::elements_of(
-        traversedSquares(square, *destination, Origin::kSkip));
+template <Color Us, typename Allocator>
+inline auto pawnSlidingMove(std::allocator_arg_t /*tag*/, Allocator alloc,
+                            Square square) -> std::generator<Square> {
+  if (auto destination = farthestPawnPush(square, Us)) {
+    co_yield std::ranges::elements_of(traversedSquares(
+        std::allocator_arg, alloc, square, *destination, Origin::kSkip));
   }
 
   co_return;
 }
 
-inline auto kingMoves(Square square) -> std::generator<Square> {
+template <typename Allocator>
+inline auto kingMoves(std::allocator_arg_t /*tag*/, Allocator alloc,
+                      Square square) -> std::generator<Square> {
   static constexpr std::array<SquareOffset, 8> kOffsets = {
       {{.file_offset = 1, .rank_offset = 1},
        {.file_offset = 1, .rank_offset = 0},
@@ -160,22 +195,30 @@ inline auto kingMoves(Square square) -> std::generator<Square> {
        {.file_offset = -1, .rank_offset = 0},
        {.file_offset = -1, .rank_offset = -1}}};
 
-  co_yield std::ranges::elements_of(kOffsets | validMoves(square));
+  co_yield std::ranges::elements_of(kOffsets | validMoves(square), alloc);
 }
 
-inline auto rookSlidingMoves(Square square)
+template <typename Allocator>
+inline auto rookSlidingMoves(std::allocator_arg_t /*tag*/,
+                             Allocator alloc, Square square)
     -> std::generator<std::generator<Square>> {
-  co_yield (traversedSquares(square, {.file = square.file, .rank = Rank::k1},
+  co_yield (traversedSquares(std::allocator_arg, alloc, square,
+                             {.file = square.file, .rank = Rank::k1},
                              Origin::kSkip));
-  co_yield (traversedSquares(square, {.file = square.file, .rank = Rank::k8},
+  co_yield (traversedSquares(std::allocator_arg, alloc, square,
+                             {.file = square.file, .rank = Rank::k8},
                              Origin::kSkip));
-  co_yield (traversedSquares(square, {.file = File::kA, .rank = square.rank},
+  co_yield (traversedSquares(std::allocator_arg, alloc, square,
+                             {.file = File::kA, .rank = square.rank},
                              Origin::kSkip));
-  co_yield (traversedSquares(square, {.file = File::kH, .rank = square.rank},
+  co_yield (traversedSquares(std::allocator_arg, alloc, square,
+                             {.file = File::kH, .rank = square.rank},
                              Origin::kSkip));
 }
 
-inline auto bishopSlidingMoves(Square square)
+template <typename Allocator>
+inline auto bishopSlidingMoves(std::allocator_arg_t /*tag*/,
+                               Allocator alloc, Square square)
     -> std::generator<std::generator<Square>> {
   constexpr static std::array<Square, 4> kCorners = {
       {{.file = File::kA, .rank = Rank::k8},
@@ -185,14 +228,19 @@ inline auto bishopSlidingMoves(Square square)
 
   for (const auto& corner : kCorners) {
     auto projection = diagonalProjection(square, corner);
-    co_yield (traversedSquares(square, projection, Origin::kSkip));
+    co_yield (traversedSquares(std::allocator_arg, alloc, square, projection,
+                               Origin::kSkip));
   }
 }
 
-inline auto queenSlidingMoves(Square square)
+template <typename Allocator>
+inline auto queenSlidingMoves(std::allocator_arg_t /*tag*/,
+                              Allocator alloc, Square square)
     -> std::generator<std::generator<Square>> {
-  co_yield std::ranges::elements_of(rookSlidingMoves(square));
-  co_yield std::ranges::elements_of(bishopSlidingMoves(square));
+  co_yield std::ranges::elements_of(
+      rookSlidingMoves(std::allocator_arg, alloc, square));
+  co_yield std::ranges::elements_of(
+      bishopSlidingMoves(std::allocator_arg, alloc, square));
 }
 
 }  // namespace chesscxx::internal
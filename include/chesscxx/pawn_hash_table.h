@@ -0,0 +1,6 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_PAWN_HASH_TABLE_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_PAWN_HASH_TABLE_H_
+
+#include "hash/pawn_hash_table.h"  // IWYU pragma: export
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_PAWN_HASH_TABLE_H_
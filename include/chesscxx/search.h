@@ -0,0 +1,11 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_SEARCH_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_SEARCH_H_
+
+/// @defgroup SearchGroup Search
+#include "search/evaluation.h"     // IWYU pragma: export
+#include "search/mate_solver.h"    // IWYU pragma: export
+#include "search/search_limits.h"  // IWYU pragma: export
+#include "search/search_result.h"  // IWYU pragma: export
+#include "search/searcher.h"       // IWYU pragma: export
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_SEARCH_H_
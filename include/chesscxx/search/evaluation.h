@@ -0,0 +1,40 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_SEARCH_EVALUATION_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_SEARCH_EVALUATION_H_
+
+// IWYU pragma: private, include "../search.h"
+
+#include <bit>
+
+#include "../color.h"
+#include "../core/internal/piece_placement_bitboards.h"
+#include "../movegen/internal/position_see.h"
+#include "../piece_type.h"
+#include "../position.h"
+
+namespace chesscxx {
+
+/// @ingroup SearchGroup
+/// @brief Evaluates a position by material alone, in centipawns from the
+/// point of view of the side to move. This is the evaluation a Searcher uses
+/// when none is given.
+inline auto materialEvaluation(const Position& position) -> int {
+  using Bitboards = internal::PiecePlacementBitboards;
+  static constexpr int kCentipawnsPerPawn = 100;
+
+  const auto& piece_placement = position.piecePlacement();
+  auto us = position.activeColor();
+
+  int score = 0;
+  for (auto type : {PieceType::kPawn, PieceType::kKnight, PieceType::kBishop,
+                    PieceType::kRook, PieceType::kQueen}) {
+    auto balance =
+        std::popcount(Bitboards::pieces(piece_placement, us, type)) -
+        std::popcount(Bitboards::pieces(piece_placement, !us, type));
+    score += balance * internal::pieceValue(type) * kCentipawnsPerPawn;
+  }
+  return score;
+}
+
+}  // namespace chesscxx
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_SEARCH_EVALUATION_H_
@@ -0,0 +1,361 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_SEARCH_INTERNAL_PROOF_NUMBER_SEARCH_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_SEARCH_INTERNAL_PROOF_NUMBER_SEARCH_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include "../../color.h"
+#include "../../core/internal/position.h"
+#include "../../core/internal/position_modifier.h"
+#include "../../core/internal/zobrist.h"
+#include "../../movegen/gen_type.h"
+#include "../../movegen/internal/position_gen_type_movegen.h"
+#include "../../position.h"
+#include "../../stats.h"
+#include "../../transposition_table.h"
+#include "../../uci_move.h"
+
+namespace chesscxx::internal {
+
+// What a proof-number search leaves in its table: the proof and disproof
+// numbers of a node searched with `depth` plies left. A proven node also
+// keeps the number of plies to the mate, which is all it takes to walk the
+// proof line back out of the table. Its proof holds at any depth, so it is
+// stored at the deepest one, which the table replaces last. Eight bytes,
+// which with the slot's generation byte take two data words, so two entries
+// share a bucket.
+struct ProofEntry {
+  uint64_t proof : 24;
+  uint64_t disproof : 24;
+  uint64_t depth : 8;
+  uint64_t distance : 8;
+};
+
+using ProofTable = TranspositionTable<ProofEntry>;
+
+// A proven mate: its length in plies, as proven at the root, and the moves
+// walked back out of the table. The walk may run out of nodes, in which case
+// the moves stop short or the longest defense is not certain.
+struct Proof {
+  int distance = 0;
+  std::vector<UciMove> line;
+  bool complete = false;
+};
+
+// Depth-first proof-number search (df-pn) of a mate by a given side within a
+// number of plies. The attacker picks one move at OR nodes and the defender
+// all of them at AND nodes: a node's proof number is the number of leaves
+// still to prove to show the mate, and its disproof number the number to
+// disprove it. The search always expands the most proving node, and returns
+// from a subtree as soon as its numbers exceed the thresholds its parent
+// gave it, so it runs in memory bounded by the table.
+//
+// Entries are keyed by position alone, whatever the path to it, so draws by
+// repetition or by the fifty-move rule are not detected. Since no node is
+// searched with more plies than its parent, the search always ends.
+class ProofNumberSearch {
+ public:
+  static constexpr uint32_t kInfinite = (uint32_t{1} << 24U) - 1;
+
+  enum class Outcome : uint8_t {
+    kProven,
+    kDisproven,
+    kUnknown,
+  };
+
+  explicit ProofNumberSearch(ProofTable& table) : table_(&table) {}
+
+  // Searches for the shortest mate by the side to move within `max_ply`
+  // plies, giving up after `node_limit` nodes. A mate found is stored in
+  // `proof`.
+  //
+  // df-pn stops at the first proof it finds, however long, so the bound
+  // grows two plies at a time: the first one proven is the shortest mate.
+  auto solve(const Position& root, int max_ply, uint64_t node_limit,
+             Proof& proof) -> Outcome {
+    position_ = root;
+    attacker_ = root.activeColor();
+    nodes_ = 0;
+    node_limit_ = node_limit;
+    table_->newSearch();
+
+    for (int depth = 1; depth <= std::min(max_ply, kMaxDepth); depth += 2) {
+      auto root_numbers = mid(kInfinite, kInfinite, depth);
+      if (root_numbers.proof == 0) {
+        proof.distance = static_cast<int>(root_numbers.distance);
+        proof.complete = appendProofLine(proof.distance, proof.line);
+        return Outcome::kProven;
+      }
+      if (root_numbers.disproof != 0) return Outcome::kUnknown;
+    }
+    return Outcome::kDisproven;
+  }
+
+  auto nodes() const -> uint64_t { return nodes_; }
+
+ private:
+  static constexpr int kMaxDepth = std::numeric_limits<uint8_t>::max();
+
+  // Distinguishes the entries of the two attackers, which may share a table.
+  static constexpr ZobristKey kBlackAttackerKey = 0x9E3779B97F4A7C15;
+
+  struct Child {
+    UciMove move;
+    ZobristKey key;
+  };
+
+  static constexpr auto proven(int distance) -> ProofEntry {
+    return {.proof = 0,
+            .disproof = kInfinite,
+            .depth = kMaxDepth,
+            .distance = static_cast<uint64_t>(distance)};
+  }
+  static constexpr auto disproven(int depth) -> ProofEntry {
+    return {.proof = kInfinite,
+            .disproof = 0,
+            .depth = static_cast<uint64_t>(depth),
+            .distance = 0};
+  }
+  static constexpr auto unknown(int depth) -> ProofEntry {
+    return {.proof = 1,
+            .disproof = 1,
+            .depth = static_cast<uint64_t>(depth),
+            .distance = 0};
+  }
+
+  // Infinity absorbs everything; finite sums stop just short of it.
+  static constexpr auto add(uint32_t lhs, uint32_t rhs) -> uint32_t {
+    if (lhs == kInfinite || rhs == kInfinite) return kInfinite;
+    return std::min(lhs + rhs, kInfinite - 1);
+  }
+
+  auto key() const -> ZobristKey {
+    return position_.zobristKey() ^
+           (attacker_ == Color::kBlack ? kBlackAttackerKey : 0);
+  }
+
+  auto isAttacking() const -> bool {
+    return position_.activeColor() == attacker_;
+  }
+
+  // A mate within `distance` plies is one within any more plies, and no
+  // mate within `depth` plies means none within fewer. Other numbers only
+  // hold for the depth they were searched at.
+  auto lookup(ZobristKey key, int depth) const -> ProofEntry {
+    auto entry = table_->probe(key);
+    if (!entry) return unknown(depth);
+    if (entry->proof == 0) {
+      return static_cast<int>(entry->distance) <= depth ? *entry
+                                                        : unknown(depth);
+    }
+    if (entry->disproof == 0) {
+      return static_cast<int>(entry->depth) >= depth ? *entry : unknown(depth);
+    }
+    return static_cast<int>(entry->depth) == depth ? *entry : unknown(depth);
+  }
+
+  auto legalMoves() {
+    auto alloc = statsAllocator(std::pmr::polymorphic_allocator<>(&resource_));
+    return legalMovesOfType<GenType::kAll>(std::allocator_arg, alloc,
+                                           position_);
+  }
+
+  // The multiple iterative deepening step of df-pn: searches the current
+  // position until its numbers reach the thresholds, and returns them.
+  auto mid(uint32_t proof_threshold, uint32_t disproof_threshold, int depth)
+      -> ProofEntry {
+    auto node_key = key();
+    if (++nodes_ > node_limit_) return lookup(node_key, depth);
+
+    auto terminal = evaluateTerminal(depth);
+    if (terminal) {
+      table_->store(node_key, *terminal);
+      return *terminal;
+    }
+
+    bool const attacking = isAttacking();
+    std::pmr::vector<Child> children(&resource_);
+    for (const auto& move : legalMoves()) {
+      auto record = PositionModifier::move(position_, move);
+      children.push_back({.move = move, .key = key()});
+      PositionModifier::undoMove(position_, *record);
+    }
+
+    while (true) {
+      auto [numbers, best, second_best] = combine(children, depth, attacking);
+      if (numbers.proof >= proof_threshold ||
+          numbers.disproof >= disproof_threshold || nodes_ > node_limit_) {
+        table_->store(node_key, numbers);
+        return numbers;
+      }
+
+      // The thresholds of the most proving child stop it once a sibling
+      // becomes easier, or once the node's own thresholds are reached.
+      auto child = lookup(children.at(best).key, depth - 1);
+      auto sibling_bound = add(second_best, 1);
+      uint32_t child_proof = 0;
+      uint32_t child_disproof = 0;
+      if (attacking) {
+        child_proof = std::min(proof_threshold, sibling_bound);
+        child_disproof = add(disproof_threshold - numbers.disproof,
+                             static_cast<uint32_t>(child.disproof));
+      } else {
+        child_proof = add(proof_threshold - numbers.proof,
+                          static_cast<uint32_t>(child.proof));
+        child_disproof = std::min(disproof_threshold, sibling_bound);
+      }
+
+      auto record = PositionModifier::move(position_, children.at(best).move);
+      mid(child_proof, child_disproof, depth - 1);
+      PositionModifier::undoMove(position_, *record);
+    }
+  }
+
+  // Nodes decided without searching their children: the defender is
+  // checkmated, a side is stalemated or the attacker mated, no plies are
+  // left, or the attacker has a single ply left to mate in.
+  auto evaluateTerminal(int depth) -> std::optional<ProofEntry> {
+    bool const attacking = isAttacking();
+    if (!hasLegalMove(position_)) {
+      bool const mated = !attacking && isCheck(position_);
+      return mated ? proven(0) : disproven(kMaxDepth);
+    }
+    // The attacker needs a ply to mate after the defender's move.
+    if (depth == 0 || (!attacking && depth == 1)) return disproven(depth);
+    if (attacking && depth == 1) {
+      for (const auto& move : legalMoves()) {
+        auto record = PositionModifier::move(position_, move);
+        bool const mates = isCheckmate(position_);
+        if (mates) table_->store(key(), proven(0));
+        PositionModifier::undoMove(position_, *record);
+        if (mates) return proven(1);
+      }
+      return disproven(1);
+    }
+    return std::nullopt;
+  }
+
+  struct Combined {
+    ProofEntry numbers;
+    size_t best;
+    uint32_t second_best;
+  };
+
+  // OR nodes are as easy to prove as their easiest child and as hard to
+  // disprove as all of their children; AND nodes the other way round. The
+  // best child is the most proving one: the easiest to prove at OR nodes,
+  // the easiest to disprove at AND nodes.
+  auto combine(const std::pmr::vector<Child>& children, int depth,
+               bool attacking) const -> Combined {
+    size_t best = 0;
+    uint32_t best_value = kInfinite;
+    uint32_t second_value = kInfinite;
+    uint32_t sum = 0;
+    int distance = attacking ? kMaxDepth : 0;
+
+    for (size_t i = 0; i < children.size(); ++i) {
+      auto numbers = lookup(children.at(i).key, depth - 1);
+      auto minimized = static_cast<uint32_t>(attacking ? numbers.proof
+                                                       : numbers.disproof);
+      auto summed = static_cast<uint32_t>(attacking ? numbers.disproof
+                                                    : numbers.proof);
+      if (minimized < best_value) {
+        second_value = best_value;
+        best_value = minimized;
+        best = i;
+      } else if (minimized < second_value) {
+        second_value = minimized;
+      }
+      sum = add(sum, summed);
+
+      if (numbers.proof == 0) {
+        auto child_distance = static_cast<int>(numbers.distance);
+        distance = attacking ? std::min(distance, child_distance)
+                             : std::max(distance, child_distance);
+      }
+    }
+
+    ProofEntry numbers = attacking ? ProofEntry{.proof = best_value,
+                                                .disproof = sum}
+                                   : ProofEntry{.proof = sum,
+                                                .disproof = best_value};
+    numbers.depth = static_cast<uint64_t>(depth);
+    if (numbers.proof == 0) {
+      numbers.depth = kMaxDepth;
+      numbers.distance = static_cast<uint64_t>(distance + 1);
+    }
+    return {.numbers = numbers, .best = best, .second_best = second_value};
+  }
+
+  // Walks the proof from the root: the attacker plays the quickest mate and
+  // the defender the slowest. Nodes whose entries were replaced are searched
+  // again, which the proven entries around them make quick, within another
+  // node limit's worth of nodes. Returns whether the walk reached the mate
+  // and settled every defense on the way: once the nodes run out, it stops.
+  auto appendProofLine(int depth, std::vector<UciMove>& line) -> bool {
+    auto root = position_;
+    node_limit_ = nodes_ + node_limit_;
+    bool searched_again = false;
+
+    while (depth > 0) {
+      bool const attacking = isAttacking();
+      std::optional<UciMove> next;
+      int next_distance = attacking ? kMaxDepth + 1 : -1;
+      bool unsettled = false;
+
+      for (const auto& move : legalMoves()) {
+        auto record = PositionModifier::move(position_, move);
+        auto numbers = lookup(key(), depth - 1);
+        if (!attacking && numbers.proof != 0 && numbers.disproof != 0) {
+          numbers = mid(kInfinite, kInfinite, depth - 1);
+        }
+        PositionModifier::undoMove(position_, *record);
+
+        // Every defense of a proven node is mated, so one that is not
+        // proven yet could only be left unsettled by the node limit.
+        if (!attacking && numbers.proof != 0) {
+          unsettled = true;
+          break;
+        }
+        if (numbers.proof != 0) continue;
+        auto distance = static_cast<int>(numbers.distance);
+        if (attacking ? distance < next_distance : distance > next_distance) {
+          next = move;
+          next_distance = distance;
+        }
+      }
+
+      if (!next && attacking && !searched_again) {
+        searched_again = true;
+        mid(kInfinite, kInfinite, depth);
+        continue;
+      }
+      if (!next || unsettled) break;
+
+      line.push_back(*next);
+      std::ignore = PositionModifier::move(position_, *next);
+      depth = next_distance;
+      searched_again = false;
+    }
+    position_ = root;
+    return depth == 0;
+  }
+
+  ProofTable* table_;
+  Position position_;
+  Color attacker_ = Color::kWhite;
+  uint64_t nodes_ = 0;
+  uint64_t node_limit_ = 0;
+  std::pmr::unsynchronized_pool_resource resource_;
+};
+
+}  // namespace chesscxx::internal
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_SEARCH_INTERNAL_PROOF_NUMBER_SEARCH_H_
@@ -0,0 +1,79 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_SEARCH_INTERNAL_SEARCH_ENTRY_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_SEARCH_INTERNAL_SEARCH_ENTRY_H_
+
+#include <cstdint>
+#include <optional>
+
+#include "../../core/internal/bitboard.h"
+#include "../../piece_type.h"
+#include "../../square.h"
+#include "../../transposition_table.h"
+#include "../../uci_move.h"
+#include "../search_result.h"
+
+namespace chesscxx::internal {
+
+enum class Bound : uint8_t {
+  kExact,
+  kLower,
+  kUpper,
+};
+
+// A UCI move packed in 16 bits: 6 bits per square and 3 bits for the
+// promotion, 0 meaning none. No move packs to 0, as a move never goes back
+// to its origin.
+using PackedMove = uint16_t;
+
+constexpr auto packMove(const std::optional<UciMove>& move) -> PackedMove {
+  if (!move) return 0;
+
+  auto packed = index(move->origin) | (index(move->destination) << 6U);
+  if (move->promotion) {
+    packed |= (static_cast<unsigned>(*move->promotion) + 1) << 12U;
+  }
+  return static_cast<PackedMove>(packed);
+}
+
+constexpr auto unpackMove(PackedMove packed) -> std::optional<UciMove> {
+  if (packed == 0) return std::nullopt;
+
+  std::optional<PromotablePieceType> promotion;
+  if (auto promotion_bits = packed >> 12U; promotion_bits != 0) {
+    promotion = static_cast<PromotablePieceType>(promotion_bits - 1);
+  }
+  return UciMove(squareFromIndex(packed & 63U),
+                 squareFromIndex((packed >> 6U) & 63U), promotion);
+}
+
+// What a search node leaves in the transposition table. Six bytes, which
+// with the slot's generation byte fit its single data word, so four entries
+// share a bucket.
+struct SearchEntry {
+  PackedMove move = 0;
+  int16_t score = 0;
+  int8_t depth = 0;
+  Bound bound = Bound::kExact;
+};
+
+static_assert(sizeof(SearchEntry) < sizeof(uint64_t),
+              "a search entry must fit one data word of a table slot");
+
+using SearchTable = TranspositionTable<SearchEntry>;
+
+// Mate scores count plies from the root, but the table may return an entry
+// at another ply, so they are stored counting from the node itself.
+constexpr auto scoreToTable(int score, int ply) -> int16_t {
+  if (score >= kMinMateScore) score += ply;
+  if (score <= -kMinMateScore) score -= ply;
+  return static_cast<int16_t>(score);
+}
+
+constexpr auto scoreFromTable(int score, int ply) -> int {
+  if (score >= kMinMateScore) return score - ply;
+  if (score <= -kMinMateScore) return score + ply;
+  return score;
+}
+
+}  // namespace chesscxx::internal
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_SEARCH_INTERNAL_SEARCH_ENTRY_H_
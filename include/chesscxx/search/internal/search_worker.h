@@ -0,0 +1,450 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_SEARCH_INTERNAL_SEARCH_WORKER_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_SEARCH_INTERNAL_SEARCH_WORKER_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "../../color.h"
+#include "../../core/internal/bitboard.h"
+#include "../../core/internal/piece_placement_bitboards.h"
+#include "../../core/internal/piece_placement_material.h"
+#include "../../core/internal/piece_placement_piece_at.h"
+#include "../../core/internal/position_modifier.h"
+#include "../../core/internal/zobrist.h"
+#include "../../movegen/gen_type.h"
+#include "../../movegen/internal/position_gen_type_movegen.h"
+#include "../../movegen/internal/position_see.h"
+#include "../../movegen/internal/position_staged_movegen.h"
+#include "../../piece_type.h"
+#include "../../position.h"
+#include "../../square.h"
+#include "../../stats.h"
+#include "../../uci_move.h"
+#include "../search_limits.h"
+#include "../search_result.h"
+#include "search_entry.h"
+
+namespace chesscxx::internal {
+
+inline constexpr int kMaxPly = 128;
+inline constexpr int kInfiniteScore = kMateScore + 1;
+
+// What the threads of a search share. Each thread reads the limits and
+// raises `stop` when it finds one reached.
+struct SharedSearchState {
+  SearchTable* table = nullptr;
+  SearchLimits limits;
+  std::chrono::steady_clock::time_point start;
+  std::atomic<bool> stop = false;
+  std::atomic<uint64_t> nodes = 0;
+
+  auto elapsed() const -> std::chrono::milliseconds {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+  }
+};
+
+// The legal moves of a node with their ordering scores. No position has more
+// than 218 legal moves.
+class MoveList {
+ public:
+  static constexpr size_t kCapacity = 256;
+
+  void push(const UciMove& move) {
+    moves_.at(size_) = move;
+    scores_.at(size_) = 0;
+    ++size_;
+  }
+
+  auto size() const -> size_t { return size_; }
+  auto empty() const -> bool { return size_ == 0; }
+  auto move(size_t i) const -> const UciMove& { return moves_.at(i); }
+  auto score(size_t i) -> int& { return scores_.at(i); }
+
+  // Moves the best scored of the remaining moves to the given place, so the
+  // moves are sorted only as far as the search gets before a cutoff.
+  auto pickNext(size_t i) -> const UciMove& {
+    auto best = i;
+    for (auto j = i + 1; j < size_; ++j) {
+      if (scores_.at(j) > scores_.at(best)) best = j;
+    }
+    std::swap(moves_.at(i), moves_.at(best));
+    std::swap(scores_.at(i), scores_.at(best));
+    return moves_.at(i);
+  }
+
+ private:
+  std::array<UciMove, kCapacity> moves_{};
+  std::array<int, kCapacity> scores_{};
+  size_t size_ = 0;
+};
+
+// One thread of a search. Lazy SMP runs several workers on the same root,
+// sharing only the transposition table: they race through the tree in
+// different orders, and the entries each leaves behind speed up the others.
+template <typename Evaluator>
+class SearchWorker {
+ public:
+  // The keys of the positions already played, the root's last, of which
+  // the last `plies_since_null_move` were played since a null move.
+  SearchWorker(SharedSearchState& shared, const Evaluator& evaluate,
+               const Position& root, std::vector<ZobristKey> keys,
+               size_t plies_since_null_move)
+      : shared_(&shared),
+        evaluate_(&evaluate),
+        position_(root),
+        keys_(std::move(keys)),
+        null_move_index_(keys_.size() - 1 - plies_since_null_move) {
+    keys_.reserve(keys_.size() + kMaxPly);
+  }
+
+  // Searches the root to the given depth. Returns std::nullopt if the search
+  // stopped before the iteration completed, which only iterations past the
+  // first may do when `must_complete` is set.
+  auto iterate(int depth, bool must_complete) -> std::optional<SearchResult> {
+    can_stop_ = !must_complete;
+    auto score = search(-kInfiniteScore, kInfiniteScore, depth, 0, false);
+    flushNodes();
+    if (stopped()) return std::nullopt;
+
+    SearchResult result{.score = score, .depth = depth};
+    result.pv.assign(pv_.front().begin(),
+                     pv_.front().begin() + pv_length_.front());
+    if (!result.pv.empty()) result.best_move = result.pv.front();
+    return result;
+  }
+
+ private:
+  static constexpr uint64_t kNodesPerCheck = 256;
+  static constexpr int kNullMoveReduction = 2;
+  static constexpr int kTableMoveScore = 1 << 30;
+  static constexpr int kCaptureScore = 1 << 28;
+  static constexpr int kKillerScore = 1 << 27;
+
+  auto search(int alpha, int beta, int depth, int ply, bool allow_null)
+      -> int {
+    bool const is_pv = beta - alpha > 1;
+    pv_length_.at(ply) = ply;
+
+    if (ply > 0 && isDraw()) return 0;
+    if (ply >= kMaxPly - 1) return (*evaluate_)(position_);
+
+    bool const in_check = isInCheck();
+    if (in_check) ++depth;
+    if (depth <= 0) return quiescence(alpha, beta, ply);
+
+    countNode();
+    if (stopped()) return 0;
+
+    auto key = keys_.back();
+    std::optional<UciMove> table_move;
+    if (auto entry = shared_->table->probe(key)) {
+      table_move = unpackMove(entry->move);
+      auto score = scoreFromTable(entry->score, ply);
+      if (!is_pv && entry->depth >= depth && isUsable(*entry, score, alpha,
+                                                      beta)) {
+        return score;
+      }
+    }
+
+    if (!is_pv && !in_check && allow_null && depth > kNullMoveReduction &&
+        hasNonPawnMaterial() && (*evaluate_)(position_) >= beta) {
+      if (auto record = PositionModifier::makeNullMove(position_)) {
+        keys_.push_back(position_.zobristKey());
+        auto previous_null_move_index =
+            std::exchange(null_move_index_, keys_.size() - 1);
+        auto score = -search(-beta, -beta + 1, depth - kNullMoveReduction - 1,
+                             ply + 1, false);
+        null_move_index_ = previous_null_move_index;
+        keys_.pop_back();
+        PositionModifier::undoNullMove(position_, *record);
+
+        if (stopped()) return 0;
+        if (score >= beta && score < kMinMateScore) return score;
+      }
+    }
+
+    MoveList moves;
+    generate<GenType::kAll>(moves);
+    if (moves.empty()) return in_check ? -kMateScore + ply : 0;
+    scoreMoves(moves, table_move, ply);
+
+    auto original_alpha = alpha;
+    auto best_score = -kInfiniteScore;
+    std::optional<UciMove> best_move;
+
+    for (size_t i = 0; i < moves.size(); ++i) {
+      auto move = moves.pickNext(i);
+      bool const is_quiet = isQuiet(move);
+
+      auto record = makeMove(move);
+      int score = 0;
+      if (i == 0) {
+        score = -search(-beta, -alpha, depth - 1, ply + 1, true);
+      } else {
+        score = -search(-alpha - 1, -alpha, depth - 1, ply + 1, true);
+        if (score > alpha && score < beta) {
+          score = -search(-beta, -alpha, depth - 1, ply + 1, true);
+        }
+      }
+      undoMove(*record);
+
+      if (stopped()) return 0;
+      if (score <= best_score) continue;
+
+      best_score = score;
+      best_move = move;
+      if (score <= alpha) continue;
+
+      alpha = score;
+      updatePv(ply, move);
+      if (alpha >= beta) {
+        if (is_quiet) rememberCutoff(move, depth, ply);
+        break;
+      }
+    }
+
+    Bound bound = Bound::kExact;
+    if (best_score >= beta) {
+      bound = Bound::kLower;
+    } else if (best_score <= original_alpha) {
+      bound = Bound::kUpper;
+    }
+    shared_->table->store(key, {.move = packMove(best_move),
+                                .score = scoreToTable(best_score, ply),
+                                .depth = static_cast<int8_t>(depth),
+                                .bound = bound});
+    return best_score;
+  }
+
+  // Searches captures and promotions only, or every evasion when in check,
+  // until the position is quiet enough for the evaluation to be trusted.
+  auto quiescence(int alpha, int beta, int ply) -> int {
+    pv_length_.at(ply) = ply;
+
+    countNode();
+    if (stopped()) return 0;
+    if (ply >= kMaxPly - 1) return (*evaluate_)(position_);
+
+    bool const in_check = isInCheck();
+    auto best_score = -kInfiniteScore;
+    if (!in_check) {
+      best_score = (*evaluate_)(position_);
+      if (best_score >= beta) return best_score;
+      alpha = std::max(alpha, best_score);
+    }
+
+    MoveList moves;
+    if (in_check) {
+      generate<GenType::kAll>(moves);
+      if (moves.empty()) return -kMateScore + ply;
+    } else {
+      generate<GenType::kCaptures>(moves);
+    }
+    scoreMoves(moves, std::nullopt, ply);
+
+    for (size_t i = 0; i < moves.size(); ++i) {
+      auto move = moves.pickNext(i);
+      // Captures losing material are left out: the side to move would
+      // rather stand pat.
+      if (!in_check && !internal::seeGreaterOrEqual(position_, move, 0)) {
+        continue;
+      }
+
+      auto record = makeMove(move);
+      auto score = -quiescence(-beta, -alpha, ply + 1);
+      undoMove(*record);
+
+      if (stopped()) return 0;
+      if (score <= best_score) continue;
+
+      best_score = score;
+      if (score <= alpha) continue;
+
+      alpha = score;
+      updatePv(ply, move);
+      if (alpha >= beta) break;
+    }
+
+    return best_score;
+  }
+
+  template <GenType Type>
+  void generate(MoveList& moves) {
+    auto alloc = statsAllocator(std::pmr::polymorphic_allocator<>(&resource_));
+    for (const auto& move :
+         legalMovesOfType<Type>(std::allocator_arg, alloc, position_)) {
+      moves.push(move);
+    }
+  }
+
+  // The move from the table first, then captures and promotions by MVV-LVA,
+  // then the quiet moves that caused cutoffs at this ply, then the other
+  // quiet moves by how often they caused cutoffs anywhere.
+  void scoreMoves(MoveList& moves, const std::optional<UciMove>& table_move,
+                  int ply) {
+    const auto& killers = killers_.at(ply);
+    for (size_t i = 0; i < moves.size(); ++i) {
+      const auto& move = moves.move(i);
+      auto& score = moves.score(i);
+
+      if (move == table_move) {
+        score = kTableMoveScore;
+      } else if (!isQuiet(move)) {
+        score = kCaptureScore + internal::mvvLvaScore(position_, move);
+      } else if (move == killers.front() || move == killers.back()) {
+        score = kKillerScore;
+      } else {
+        score = history_.at(index(move.origin)).at(index(move.destination));
+      }
+    }
+  }
+
+  void rememberCutoff(const UciMove& move, int depth, int ply) {
+    auto& killers = killers_.at(ply);
+    if (killers.front() != move) {
+      killers.back() = killers.front();
+      killers.front() = move;
+    }
+
+    auto& history =
+        history_.at(index(move.origin)).at(index(move.destination));
+    history = std::min(history + (depth * depth), kKillerScore - 1);
+  }
+
+  void updatePv(int ply, const UciMove& move) {
+    auto& line = pv_.at(ply);
+    const auto& child = pv_.at(ply + 1);
+    line.at(ply) = move;
+    std::copy(child.begin() + ply + 1, child.begin() + pv_length_.at(ply + 1),
+              line.begin() + ply + 1);
+    pv_length_.at(ply) = std::max(pv_length_.at(ply + 1), ply + 1);
+  }
+
+  auto makeMove(const UciMove& move) -> std::optional<MoveRecord> {
+    auto record = PositionModifier::move(position_, move);
+    if (!record) return std::nullopt;
+
+    keys_.push_back(position_.zobristKey());
+    return *record;
+  }
+
+  void undoMove(const MoveRecord& record) {
+    keys_.pop_back();
+    PositionModifier::undoMove(position_, record);
+  }
+
+  auto isQuiet(const UciMove& move) const -> bool {
+    return !move.promotion && !hasPieceAt(position_.piecePlacement(),
+                                          move.destination) &&
+           !(move.destination == position_.enPassantTargetSquare() &&
+             hasPieceAt(position_.piecePlacement(), move.origin,
+                        {.type = PieceType::kPawn,
+                         .color = position_.activeColor()}));
+  }
+
+  auto isInCheck() const -> bool {
+    using Bitboards = PiecePlacementBitboards;
+    const auto& piece_placement = position_.piecePlacement();
+    auto us = position_.activeColor();
+    auto king = Bitboards::pieces(piece_placement, us, PieceType::kKing);
+
+    return (attackersTo(piece_placement, lsbIndex(king),
+                        Bitboards::occupancy(piece_placement)) &
+            Bitboards::pieces(piece_placement, !us)) != 0;
+  }
+
+  auto hasNonPawnMaterial() const -> bool {
+    using Bitboards = PiecePlacementBitboards;
+    const auto& piece_placement = position_.piecePlacement();
+    auto us = position_.activeColor();
+
+    return (Bitboards::pieces(piece_placement, us) &
+            ~Bitboards::pieces(piece_placement, PieceType::kPawn) &
+            ~Bitboards::pieces(piece_placement, PieceType::kKing)) != 0;
+  }
+
+  // A repetition of any earlier position counts as a draw: if it was good
+  // for either side, that side would not have let it repeat. The halfmove
+  // clock keeps counting through null moves, but the positions before one
+  // cannot come back.
+  auto isDraw() const -> bool {
+    if (position_.halfmoveClock() >= 2 * 50) return true;
+    if (isInsufficientMaterialDraw(position_.piecePlacement())) return true;
+
+    auto key = keys_.back();
+    auto reversible_plies = std::min<size_t>(
+        keys_.size() - 1 - null_move_index_, position_.halfmoveClock());
+    for (size_t i = 4; i <= reversible_plies; i += 2) {
+      if (keys_.at(keys_.size() - 1 - i) == key) return true;
+    }
+    return false;
+  }
+
+  static auto isUsable(const SearchEntry& entry, int score, int alpha,
+                       int beta) -> bool {
+    switch (entry.bound) {
+      case Bound::kExact:
+        return true;
+      case Bound::kLower:
+        return score >= beta;
+      case Bound::kUpper:
+        return score <= alpha;
+    }
+    return false;
+  }
+
+  void countNode() {
+    if (++pending_nodes_ < kNodesPerCheck) return;
+
+    auto nodes = flushNodes();
+    if (!can_stop_) return;
+
+    const auto& limits = shared_->limits;
+    if ((limits.nodes && nodes >= *limits.nodes) ||
+        (limits.time && shared_->elapsed() >= *limits.time)) {
+      shared_->stop.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  auto flushNodes() -> uint64_t {
+    auto nodes = shared_->nodes.fetch_add(pending_nodes_,
+                                          std::memory_order_relaxed) +
+                 pending_nodes_;
+    pending_nodes_ = 0;
+    return nodes;
+  }
+
+  auto stopped() const -> bool {
+    return can_stop_ && shared_->stop.load(std::memory_order_relaxed);
+  }
+
+  SharedSearchState* shared_;
+  const Evaluator* evaluate_;
+  Position position_;
+  std::vector<ZobristKey> keys_;
+  // The index in keys_ of the position the last null move led to.
+  size_t null_move_index_;
+  std::pmr::unsynchronized_pool_resource resource_;
+
+  std::array<std::array<UciMove, kMaxPly>, kMaxPly> pv_{};
+  std::array<int, kMaxPly> pv_length_{};
+  std::array<std::array<std::optional<UciMove>, 2>, kMaxPly> killers_{};
+  std::array<std::array<int, kNumSquares>, kNumSquares> history_{};
+
+  uint64_t pending_nodes_ = 0;
+  bool can_stop_ = false;
+};
+
+}  // namespace chesscxx::internal
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_SEARCH_INTERNAL_SEARCH_WORKER_H_
@@ -0,0 +1,175 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_SEARCH_MATE_SOLVER_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_SEARCH_MATE_SOLVER_H_
+
+// IWYU pragma: private, include "../search.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../position.h"
+#include "../uci_move.h"
+#include "internal/proof_number_search.h"
+
+namespace chesscxx {
+
+/// @addtogroup SearchGroup
+/// @{
+
+/// @brief What a MateSolver found out about a position.
+enum class MateStatus : uint8_t {
+  /// @brief The side to move mates within the given number of plies.
+  kProven,
+  /// @brief The side to move cannot force a mate within the given number of
+  /// plies.
+  kDisproven,
+  /// @brief The node limit was reached first.
+  kUnknown,
+};
+
+/// @brief The outcome of a mate search.
+struct MateResult {
+  /// @brief Whether a mate was proven.
+  MateStatus status = MateStatus::kUnknown;
+  /// @brief The number of plies to checkmate, when proven.
+  int plies = 0;
+  /// @brief The moves of the shortest mate, with the defender delaying it
+  /// the longest, when proven. They are read back from the transposition
+  /// table, which may take more searching: see `line_complete`.
+  std::vector<UciMove> line;
+  /// @brief Whether `line` is the whole mate. If the nodes run out while it
+  /// is read back, it stops short, before the first move the search could
+  /// not settle.
+  bool line_complete = false;
+  /// @brief The number of nodes searched.
+  uint64_t nodes = 0;
+
+  /// @brief Returns the number of moves to checkmate, if proven.
+  auto mateIn() const -> std::optional<int> {
+    if (status != MateStatus::kProven) return std::nullopt;
+    return (plies + 1) / 2;
+  }
+};
+
+/// @brief Proves or disproves forced mates with depth-first proof-number
+/// search (df-pn).
+///
+/// Proof-number search expands whichever leaf would most help to settle the
+/// question "can the side to move force a mate?", which makes it much faster
+/// than alpha-beta search at finding deep, narrow mates. The solver keeps
+/// its own transposition table, whose size bounds its memory, and reuses it
+/// from one position to the next.
+///
+/// Draws by repetition and by the fifty-move rule are not considered.
+class MateSolver {
+ public:
+  /// @brief The table size used when none is given, in bytes.
+  static constexpr size_t kDefaultTableBytes = size_t{16} << 20U;
+
+  /// @name Constructors
+  /// @{
+
+  /// @brief Constructs a solver with a transposition table using at most
+  /// the given number of bytes.
+  explicit MateSolver(size_t table_bytes = kDefaultTableBytes)
+      : table_(table_bytes) {}
+
+  /// @}
+
+  /// @name Solving
+  /// @{
+
+  /// @brief Searches for a mate by the side to move.
+  /// @param position The position to solve.
+  /// @param max_ply The longest mate to look for, in plies: a mate in N
+  /// moves takes 2N - 1 plies. At most 255.
+  /// @param node_limit The number of nodes after which the search gives up.
+  auto solve(const Position& position, int max_ply, uint64_t node_limit)
+      -> MateResult {
+    internal::ProofNumberSearch search(table_);
+
+    MateResult result;
+    internal::Proof proof;
+    switch (search.solve(position, max_ply, node_limit, proof)) {
+      case internal::ProofNumberSearch::Outcome::kProven:
+        result.status = MateStatus::kProven;
+        result.plies = proof.distance;
+        result.line = std::move(proof.line);
+        result.line_complete = proof.complete;
+        break;
+      case internal::ProofNumberSearch::Outcome::kDisproven:
+        result.status = MateStatus::kDisproven;
+        break;
+      case internal::ProofNumberSearch::Outcome::kUnknown:
+        result.status = MateStatus::kUnknown;
+        break;
+    }
+    result.nodes = search.nodes();
+    return result;
+  }
+
+  /// @brief Empties the transposition table.
+  void clear() { table_.clear(); }
+
+  /// @}
+
+ private:
+  internal::ProofTable table_;
+};
+
+/// @brief Searches for a mate by the side to move with a new MateSolver.
+/// See MateSolver::solve().
+inline auto solveMate(const Position& position, int max_ply,
+                      uint64_t node_limit) -> MateResult {
+  return MateSolver().solve(position, max_ply, node_limit);
+}
+
+/// @brief Searches each of the positions for a mate by its side to move,
+/// spreading them over several threads.
+///
+/// Each thread owns a MateSolver, so memory stays bounded by
+/// `num_threads * table_bytes` however many positions there are.
+/// @param positions The positions to solve.
+/// @param max_ply The longest mate to look for, in plies.
+/// @param node_limit The node limit of each position.
+/// @param num_threads The number of threads, all hardware threads if zero.
+/// @param table_bytes The table size of each thread's solver.
+/// @return The result of each position, in the same order.
+inline auto solveMates(std::span<const Position> positions, int max_ply,
+                       uint64_t node_limit, size_t num_threads = 0,
+                       size_t table_bytes = MateSolver::kDefaultTableBytes)
+    -> std::vector<MateResult> {
+  std::vector<MateResult> results(positions.size());
+  if (positions.empty()) return results;
+  if (num_threads == 0) num_threads = std::thread::hardware_concurrency();
+  num_threads = std::clamp<size_t>(num_threads, 1, positions.size());
+
+  std::atomic<size_t> next = 0;
+  auto work = [&] {
+    MateSolver solver(table_bytes);
+    for (auto i = next.fetch_add(1, std::memory_order_relaxed);
+         i < positions.size();
+         i = next.fetch_add(1, std::memory_order_relaxed)) {
+      results.at(i) = solver.solve(positions[i], max_ply, node_limit);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (size_t i = 1; i < num_threads; ++i) threads.emplace_back(work);
+  work();
+  for (auto& thread : threads) thread.join();
+  return results;
+}
+
+/// @}
+
+}  // namespace chesscxx
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_SEARCH_MATE_SOLVER_H_
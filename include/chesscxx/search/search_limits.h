@@ -0,0 +1,29 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_SEARCH_SEARCH_LIMITS_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_SEARCH_SEARCH_LIMITS_H_
+
+// IWYU pragma: private, include "../search.h"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace chesscxx {
+
+/// @ingroup SearchGroup
+/// @brief Bounds a search. The search stops as soon as any of the given
+/// limits is reached, and runs until Searcher::stop() is called when none is
+/// given. The first iteration always completes, so a search always finds a
+/// move when there is one.
+struct SearchLimits {
+  /// @brief The deepest iteration to search, in plies.
+  std::optional<int> depth = std::nullopt;
+  /// @brief The number of nodes to search, summed over all threads. The
+  /// search may overshoot it by a few hundred nodes per thread.
+  std::optional<uint64_t> nodes = std::nullopt;
+  /// @brief The time to search for.
+  std::optional<std::chrono::milliseconds> time = std::nullopt;
+};
+
+}  // namespace chesscxx
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_SEARCH_SEARCH_LIMITS_H_
@@ -0,0 +1,56 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_SEARCH_SEARCH_RESULT_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_SEARCH_SEARCH_RESULT_H_
+
+// IWYU pragma: private, include "../search.h"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "../uci_move.h"
+
+namespace chesscxx {
+
+/// @addtogroup SearchGroup
+/// @{
+
+/// @brief The score of being checkmated right away. A score of
+/// `kMateScore - n` means the side to move mates in n plies, and
+/// `-kMateScore + n` that it is mated in n plies.
+inline constexpr int kMateScore = 32000;
+
+/// @brief Scores at least this far from zero announce a checkmate.
+inline constexpr int kMinMateScore = kMateScore - 1000;
+
+/// @brief The outcome of a search, or of one of its iterations.
+struct SearchResult {
+  /// @brief The best move found, or std::nullopt if the side to move has no
+  /// legal move.
+  std::optional<UciMove> best_move = std::nullopt;
+  /// @brief The score of the best move, in centipawns from the point of view
+  /// of the side to move.
+  int score = 0;
+  /// @brief The depth of the last completed iteration, in plies.
+  int depth = 0;
+  /// @brief The number of nodes searched by all threads.
+  uint64_t nodes = 0;
+  /// @brief The time spent searching.
+  std::chrono::milliseconds time{};
+  /// @brief The expected line of play, starting with the best move.
+  std::vector<UciMove> pv;
+
+  /// @brief Returns the number of moves to checkmate if the score announces
+  /// one: positive if the side to move mates, negative if it is mated.
+  auto mateIn() const -> std::optional<int> {
+    if (score >= kMinMateScore) return (kMateScore - score + 1) / 2;
+    if (score <= -kMinMateScore) return -(kMateScore + score) / 2;
+    return std::nullopt;
+  }
+};
+
+/// @}
+
+}  // namespace chesscxx
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_SEARCH_SEARCH_RESULT_H_
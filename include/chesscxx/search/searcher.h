@@ -0,0 +1,216 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_SEARCH_SEARCHER_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_SEARCH_SEARCHER_H_
+
+// IWYU pragma: private, include "../search.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../core/internal/zobrist.h"
+#include "../game.h"
+#include "../position.h"
+#include "../uci_move.h"
+#include "evaluation.h"
+#include "internal/search_entry.h"
+#include "internal/search_worker.h"
+#include "search_limits.h"
+#include "search_result.h"
+
+namespace chesscxx {
+
+/// @addtogroup SearchGroup
+/// @{
+
+/// @brief Type alias for the evaluation a Searcher uses when none is given.
+using MaterialEvaluator = decltype(&materialEvaluation);
+
+/// @brief Finds the best move of a game's current position by iterative
+/// deepening alpha-beta search.
+///
+/// Each iteration runs a principal variation search with null move pruning,
+/// followed by a quiescence search of captures. Moves are tried in order: the
+/// move stored in the transposition table, captures by MVV-LVA, then killer
+/// and history moves.
+///
+/// With several threads, the search uses Lazy SMP: every thread searches the
+/// same position, starting at alternating depths, and the threads share only
+/// the transposition table. The result is that of the first thread.
+///
+/// @tparam Evaluator Called as `evaluate(position)` to score a position, in
+/// centipawns from the point of view of the side to move. It is shared by all
+/// threads, so it must be safe to call concurrently.
+template <typename Evaluator = MaterialEvaluator>
+  requires std::is_invocable_r_v<int, const Evaluator&, const Position&>
+class Searcher {
+ public:
+  /// @brief Callback invoked after each completed iteration of the first
+  /// thread, with the result of that iteration.
+  using IterationCallback = std::function<void(const SearchResult&)>;
+
+  /// @brief The transposition table size used when none is given, in bytes.
+  static constexpr size_t kDefaultHashBytes = size_t{16} << 20U;
+
+  /// @name Constructors
+  /// @{
+
+  /// @brief Constructs a searcher with its own transposition table.
+  /// @param evaluate The evaluation of positions.
+  /// @param hash_bytes The memory budget of the transposition table.
+  /// @param num_threads The number of threads searching, at least one.
+  explicit Searcher(Evaluator evaluate = &materialEvaluation,
+                    size_t hash_bytes = kDefaultHashBytes,
+                    size_t num_threads = 1)
+      : evaluate_(std::move(evaluate)),
+        table_(std::make_unique<internal::SearchTable>(hash_bytes)),
+        num_threads_(std::max<size_t>(num_threads, 1)) {}
+
+  /// @}
+
+  /// @name Search
+  /// @{
+
+  /// @brief Searches the current position of the game until a limit is
+  /// reached or stop() is called. A stop() called before the search starts
+  /// still ends it, after the first iteration.
+  /// @param game The game to search. Its moves are used to detect
+  /// repetitions.
+  /// @param limits When to stop.
+  /// @param on_iteration Called after each completed iteration.
+  /// @return The result of the last completed iteration.
+  auto search(const Game& game, const SearchLimits& limits,
+              const IterationCallback& on_iteration = {}) -> SearchResult {
+    shared_.table = table_.get();
+    shared_.limits = limits;
+    shared_.start = std::chrono::steady_clock::now();
+    shared_.nodes.store(0, std::memory_order_relaxed);
+    table_->newSearch();
+
+    const auto& keys = game.zobristKeys();
+    const auto& root = game.currentPosition();
+    auto plies_since_null_move = game.pliesSinceNullMove();
+
+    std::vector<std::thread> helpers;
+    helpers.reserve(num_threads_ - 1);
+    for (size_t i = 1; i < num_threads_; ++i) {
+      helpers.emplace_back([this, &root, keys, plies_since_null_move, i] {
+        internal::SearchWorker<Evaluator> worker(shared_, evaluate_, root,
+                                                 keys, plies_since_null_move);
+        // Half of the helpers search one ply deeper, so the threads spread
+        // over more of the tree.
+        for (auto depth = 1 + static_cast<int>(i % 2);
+             depth < internal::kMaxPly; ++depth) {
+          if (!worker.iterate(depth, false)) break;
+        }
+      });
+    }
+
+    auto result =
+        searchMainThread(root, keys, plies_since_null_move, on_iteration);
+
+    shared_.stop.store(true, std::memory_order_relaxed);
+    for (auto& helper : helpers) helper.join();
+    // Only now, so that no stop() aimed at this search is lost.
+    clearStop();
+
+    result.nodes = shared_.nodes.load(std::memory_order_relaxed);
+    result.time = shared_.elapsed();
+    return result;
+  }
+
+  /// @brief Makes the running search stop as soon as possible. It returns
+  /// the result of the last completed iteration. If no search is running,
+  /// the next one stops instead. May be called from any thread.
+  void stop() { shared_.stop.store(true, std::memory_order_relaxed); }
+
+  /// @brief Withdraws a stop() that no search has acted on. A caller
+  /// starting searches on another thread calls it before starting one, so
+  /// that a stop() meant for an earlier search, which may have ended on its
+  /// own, does not end the new one.
+  void clearStop() { shared_.stop.store(false, std::memory_order_relaxed); }
+
+  /// @}
+
+  /// @name Configuration
+  /// @{
+
+  /// @brief Sets the number of threads used by the next searches.
+  void setNumThreads(size_t num_threads) {
+    num_threads_ = std::max<size_t>(num_threads, 1);
+  }
+  /// @brief Returns the number of threads used by searches.
+  auto numThreads() const -> size_t { return num_threads_; }
+
+  /// @brief Replaces the transposition table with an empty one of the given
+  /// size. Must not be called during a search.
+  void setHashBytes(size_t hash_bytes) {
+    table_ = std::make_unique<internal::SearchTable>(hash_bytes);
+  }
+  /// @brief Empties the transposition table. Must not be called during a
+  /// search.
+  void clearHash() { table_->clear(); }
+  /// @brief Returns the share of the transposition table, in permille,
+  /// filled by the current or last search.
+  auto hashfull() const -> int { return table_->hashfull(); }
+
+  /// @}
+
+ private:
+  auto searchMainThread(const Position& root,
+                        std::vector<internal::ZobristKey> keys,
+                        size_t plies_since_null_move,
+                        const IterationCallback& on_iteration)
+      -> SearchResult {
+    internal::SearchWorker<Evaluator> worker(
+        shared_, evaluate_, root, std::move(keys), plies_since_null_move);
+    auto max_depth = std::min(shared_.limits.depth.value_or(internal::kMaxPly),
+                              internal::kMaxPly - 1);
+
+    SearchResult result;
+    for (int depth = 1; depth <= max_depth; ++depth) {
+      auto iteration = worker.iterate(depth, depth == 1);
+      if (!iteration) break;
+
+      result = std::move(*iteration);
+      if (on_iteration) {
+        result.nodes = shared_.nodes.load(std::memory_order_relaxed);
+        result.time = shared_.elapsed();
+        on_iteration(result);
+      }
+
+      // Nothing to choose from, or a mate no deeper iteration can shorten.
+      if (!result.best_move || (result.mateIn() && std::abs(result.score) >=
+                                                       kMateScore - depth)) {
+        break;
+      }
+    }
+    return result;
+  }
+
+  Evaluator evaluate_;
+  std::unique_ptr<internal::SearchTable> table_;
+  size_t num_threads_;
+  internal::SharedSearchState shared_;
+};
+
+/// @brief Searches the current position of the game with a new single
+/// threaded Searcher using materialEvaluation().
+inline auto search(const Game& game, const SearchLimits& limits)
+    -> SearchResult {
+  return Searcher<>().search(game, limits);
+}
+
+/// @}
+
+}  // namespace chesscxx
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_SEARCH_SEARCHER_H_
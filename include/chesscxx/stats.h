@@ -0,0 +1,6 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_STATS_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_STATS_H_
+
+#include "core/stats.h"  // IWYU pragma: export
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_STATS_H_
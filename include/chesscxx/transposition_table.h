@@ -0,0 +1,6 @@
+#ifndef CHESSCXX_INCLUDE_CHESSCXX_TRANSPOSITION_TABLE_H_
+#define CHESSCXX_INCLUDE_CHESSCXX_TRANSPOSITION_TABLE_H_
+
+#include "hash/transposition_table.h"  // IWYU pragma: export
+
+#endif  // CHESSCXX_INCLUDE_CHESSCXX_TRANSPOSITION_TABLE_H_
@@ -0,0 +1,87 @@
+#include <chesscxx/endgame.h>
+#include <chesscxx/parse.h>
+#include <chesscxx/position.h>
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string_view>
+
+namespace {
+auto probeKPK(std::string_view fen) -> std::optional<chesscxx::BitbaseResult> {
+  return chesscxx::probeKPK(chesscxx::parse<chesscxx::Position>(fen).value());
+}
+auto probeKRK(std::string_view fen) -> std::optional<chesscxx::BitbaseResult> {
+  return chesscxx::probeKRK(chesscxx::parse<chesscxx::Position>(fen).value());
+}
+auto probeKQK(std::string_view fen) -> std::optional<chesscxx::BitbaseResult> {
+  return chesscxx::probeKQK(chesscxx::parse<chesscxx::Position>(fen).value());
+}
+}  // namespace
+
+TEST(BitbaseTest, KpkWinsOutsideTheSquareOfThePawn) {
+  EXPECT_EQ(probeKPK("7k/8/8/8/8/8/P7/K7 w - - 0 1"),
+            chesscxx::BitbaseResult::kWin);
+  EXPECT_EQ(probeKPK("7k/8/8/8/8/8/P7/K7 b - - 0 1"),
+            chesscxx::BitbaseResult::kWin);
+}
+
+TEST(BitbaseTest, KpkWinsWithTheKingOnTheSixthRank) {
+  EXPECT_EQ(probeKPK("4k3/8/4K3/4P3/8/8/8/8 w - - 0 1"),
+            chesscxx::BitbaseResult::kWin);
+  EXPECT_EQ(probeKPK("4k3/8/4K3/4P3/8/8/8/8 b - - 0 1"),
+            chesscxx::BitbaseResult::kWin);
+}
+
+TEST(BitbaseTest, KpkDependsOnTheOpposition) {
+  EXPECT_EQ(probeKPK("8/4k3/8/4K3/4P3/8/8/8 w - - 0 1"),
+            chesscxx::BitbaseResult::kDraw);
+  EXPECT_EQ(probeKPK("8/4k3/8/4K3/4P3/8/8/8 b - - 0 1"),
+            chesscxx::BitbaseResult::kWin);
+}
+
+TEST(BitbaseTest, KpkDrawsWithTheKingInFrontOfARookPawn) {
+  EXPECT_EQ(probeKPK("k7/8/8/8/8/8/P7/K7 w - - 0 1"),
+            chesscxx::BitbaseResult::kDraw);
+  EXPECT_EQ(probeKPK("7k/8/8/8/8/8/7P/7K w - - 0 1"),
+            chesscxx::BitbaseResult::kDraw);
+}
+
+TEST(BitbaseTest, KpkDrawsWhenTheUndefendedPawnIsTaken) {
+  EXPECT_EQ(probeKPK("8/8/8/8/8/8/3kP3/7K b - - 0 1"),
+            chesscxx::BitbaseResult::kDraw);
+}
+
+TEST(BitbaseTest, KpkIsSymmetricForBlack) {
+  EXPECT_EQ(probeKPK("k7/p7/8/8/8/8/8/7K w - - 0 1"),
+            chesscxx::BitbaseResult::kWin);
+  EXPECT_EQ(probeKPK("8/8/8/4p3/4k3/8/4K3/8 b - - 0 1"),
+            chesscxx::BitbaseResult::kDraw);
+  EXPECT_EQ(probeKPK("8/8/8/4p3/4k3/8/4K3/8 w - - 0 1"),
+            chesscxx::BitbaseResult::kWin);
+}
+
+TEST(BitbaseTest, KrkAndKqkWinUnlessThePieceIsLost) {
+  EXPECT_EQ(probeKRK("k7/8/1K6/8/8/8/8/7R w - - 0 1"),
+            chesscxx::BitbaseResult::kWin);
+  EXPECT_EQ(probeKRK("8/8/8/8/8/8/8/kR5K b - - 0 1"),
+            chesscxx::BitbaseResult::kDraw);
+  EXPECT_EQ(probeKQK("8/8/8/8/8/1k6/1q6/6K1 w - - 0 1"),
+            chesscxx::BitbaseResult::kWin);
+  EXPECT_EQ(probeKQK("8/8/8/8/8/8/1Qk5/7K b - - 0 1"),
+            chesscxx::BitbaseResult::kDraw);
+}
+
+TEST(BitbaseTest, KqkDetectsStalemateAndCheckmate) {
+  EXPECT_EQ(probeKQK("k7/2Q5/1K6/8/8/8/8/8 b - - 0 1"),
+            chesscxx::BitbaseResult::kDraw);
+  EXPECT_EQ(probeKQK("k7/1Q6/1K6/8/8/8/8/8 b - - 0 1"),
+            chesscxx::BitbaseResult::kWin);
+}
+
+TEST(BitbaseTest, OtherMaterialIsNotProbed) {
+  EXPECT_FALSE(probeKPK("4k3/8/8/8/8/8/4PP2/4K3 w - - 0 1"));
+  EXPECT_FALSE(probeKPK("4k3/8/8/8/8/8/8/4K2R w - - 0 1"));
+  EXPECT_FALSE(probeKRK("4k3/8/8/8/8/8/4P3/4K3 w - - 0 1"));
+  EXPECT_FALSE(probeKQK("4k3/8/8/8/8/8/8/4K2R w - - 0 1"));
+  EXPECT_FALSE(chesscxx::probeKPK(chesscxx::Position()));
+}
@@ -1,11 +1,17 @@
+#include <chesscxx/board_observer.h>
 #include <chesscxx/draw_reason.h>
+#include <chesscxx/file.h>
 #include <chesscxx/game.h>
 #include <chesscxx/game_result.h>
 #include <chesscxx/move_error.h>
 #include <chesscxx/parse.h>
 #include <chesscxx/parse_error.h>
+#include <chesscxx/piece.h>
+#include <chesscxx/piece_placement.h>
+#include <chesscxx/piece_type.h>
 #include <chesscxx/position.h>
 #include <chesscxx/san_move.h>
+#include <chesscxx/square.h>
 #include <chesscxx/uci_move.h>
 #include <gtest/gtest.h>
 #include <yaml-cpp/yaml.h>
@@ -13,6 +19,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <format>
+#include <initializer_list>
 #include <magic_enum/magic_enum.hpp>
 #include <optional>
 #include <string>
@@ -810,6 +817,134 @@ TEST_P(ValidMoveSuite, UndoMoveCorrectly) {
   EXPECT_EQ(game.currentPosition(), initial_position);
 }
 
+TEST_P(ValidMoveSuite, UpdateZobristKeyIncrementally) {
+  const auto& fixture = GetParam();
+  auto game = fixture.game();
+  auto initial_key = game.currentPosition().zobristKey();
+
+  ASSERT_TRUE(game.move(fixture.uci_move()));
+  EXPECT_EQ(game.currentPosition().zobristKey(),
+            fixture.final_position().zobristKey());
+  EXPECT_NE(game.currentPosition().zobristKey(), initial_key);
+
+  game.undoMove();
+  EXPECT_EQ(game.currentPosition().zobristKey(), initial_key);
+}
+
+TEST_P(ValidMoveSuite, UpdatePawnKeyOnlyWhenPawnsChange) {
+  const auto& fixture = GetParam();
+  auto game = fixture.game();
+  auto initial_placement = game.piecePlacement();
+  auto initial_key = game.currentPosition().pawnKey();
+
+  ASSERT_TRUE(game.move(fixture.uci_move()));
+  EXPECT_EQ(game.currentPosition().pawnKey(),
+            fixture.final_position().pawnKey());
+
+  auto pawns = [](const chesscxx::PiecePlacement& piece_placement) {
+    auto pawn_array = piece_placement.pieceArray();
+    for (auto& piece : pawn_array) {
+      if (piece && piece->type != chesscxx::PieceType::kPawn) piece.reset();
+    }
+    return pawn_array;
+  };
+  bool const pawns_changed =
+      pawns(initial_placement) != pawns(game.piecePlacement());
+  EXPECT_EQ(game.currentPosition().pawnKey() != initial_key, pawns_changed);
+
+  game.undoMove();
+  EXPECT_EQ(game.currentPosition().pawnKey(), initial_key);
+}
+
+// Keeps its own copy of the board from the changes it is told about.
+class PieceArrayObserver {
+ public:
+  explicit PieceArrayObserver(const chesscxx::PiecePlacement& piece_placement) {
+    chesscxx::addPieces(piece_placement, *this);
+    num_changes_ = 0;
+  }
+
+  void onAdd(const chesscxx::Piece& piece, const chesscxx::Square& square) {
+    auto& slot = at(square);
+    EXPECT_FALSE(slot.has_value());
+    slot = piece;
+    ++num_changes_;
+  }
+  void onRemove(const chesscxx::Piece& piece, const chesscxx::Square& square) {
+    auto& slot = at(square);
+    EXPECT_EQ(slot, piece);
+    slot.reset();
+    ++num_changes_;
+  }
+  void onMove(const chesscxx::Piece& piece, const chesscxx::Square& origin,
+              const chesscxx::Square& destination) {
+    onRemove(piece, origin);
+    onAdd(piece, destination);
+    --num_changes_;
+  }
+
+  [[nodiscard]] auto pieceArray() const
+      -> const chesscxx::PiecePlacement::PieceArray& {
+    return piece_array_;
+  }
+  [[nodiscard]] auto numChanges() const -> int { return num_changes_; }
+
+ private:
+  auto at(const chesscxx::Square& square) -> std::optional<chesscxx::Piece>& {
+    return piece_array_.at(
+        (static_cast<size_t>(square.rank) * chesscxx::kNumFiles) +
+        static_cast<size_t>(square.file));
+  }
+
+  chesscxx::PiecePlacement::PieceArray piece_array_{};
+  int num_changes_ = 0;
+};
+
+TEST_P(ValidMoveSuite, ReportPieceChangesToObserver) {
+  const auto& fixture = GetParam();
+  auto game = fixture.game();
+  PieceArrayObserver observer(game.piecePlacement());
+
+  ASSERT_TRUE(game.move(fixture.san_move(), observer));
+  EXPECT_EQ(observer.pieceArray(), game.piecePlacement().pieceArray());
+  EXPECT_LE(observer.numChanges(), 3);
+
+  game.undoMove(observer);
+  EXPECT_EQ(observer.pieceArray(),
+            fixture.game().piecePlacement().pieceArray());
+}
+
+TEST_P(ValidMoveSuite, MakeAndUndoNullMoveCorrectly) {
+  const auto& fixture = GetParam();
+  auto game = fixture.game();
+  auto initial_position = game.currentPosition();
+
+  auto null_move = game.makeNullMove();
+  if (initial_position.halfmoveClock() ==
+      chesscxx::Position::kMaxHalfmoveClock) {
+    ASSERT_FALSE(null_move);
+    EXPECT_EQ(null_move.error(), chesscxx::MoveError::kHalfmoveClockOverflow);
+    EXPECT_EQ(game.currentPosition(), initial_position);
+    return;
+  }
+
+  ASSERT_TRUE(null_move);
+  EXPECT_EQ(game.piecePlacement(), initial_position.piecePlacement());
+  EXPECT_EQ(game.activeColor(), !initial_position.activeColor());
+  EXPECT_EQ(game.enPassantTargetSquare(), std::nullopt);
+  EXPECT_EQ(game.halfmoveClock(), initial_position.halfmoveClock() + 1);
+  EXPECT_NE(game.currentPosition().zobristKey(), initial_position.zobristKey());
+  EXPECT_TRUE(game.uciMoves().empty());
+  EXPECT_EQ(game.repetitionTracker().size(), 1);
+  EXPECT_EQ(game.zobristKeys().size(), fixture.game().zobristKeys().size() + 1);
+
+  game.undoNullMove();
+  EXPECT_EQ(game.currentPosition(), initial_position);
+  EXPECT_EQ(game.currentPosition().zobristKey(), initial_position.zobristKey());
+  EXPECT_EQ(game.repetitionTracker().size(), 1);
+  EXPECT_EQ(game, fixture.game());
+}
+
 TEST_P(FormatSuite, FormatProducesExpectOutput) {
   auto fixture = GetParam();
   EXPECT_EQ(std::format("{}", fixture.game()), fixture.default_fmt());
@@ -1011,3 +1146,202 @@ TEST(GameTest, ConstructFromInitialPositionCorrectly) {
   EXPECT_FALSE(game.result());
   EXPECT_FALSE(game.drawReason());
 }
+
+TEST(GameTest, NullMoveIsRejectedInCheck) {
+  auto game = chesscxx::parse<chesscxx::Game>(
+      "4k3/8/8/8/8/8/4r3/4K3 w - - 0 1", chesscxx::parse_as::Fen{});
+  ASSERT_TRUE(game);
+  auto initial_position = game->currentPosition();
+
+  auto null_move = game->makeNullMove();
+  ASSERT_FALSE(null_move);
+  EXPECT_EQ(null_move.error(), chesscxx::MoveError::kMoveLeavesOwnKingInCheck);
+  EXPECT_EQ(game->currentPosition(), initial_position);
+}
+
+TEST(GameTest, UndoMoveUndoesNullMovesInOrder) {
+  auto game = chesscxx::Game();
+  auto e4 = chesscxx::parse<chesscxx::UciMove>("e2e4");
+  auto d4 = chesscxx::parse<chesscxx::UciMove>("d2d4");
+  ASSERT_TRUE(e4);
+  ASSERT_TRUE(d4);
+
+  ASSERT_TRUE(game.move(*e4));
+  auto after_e4 = game.currentPosition();
+  ASSERT_TRUE(game.makeNullMove());
+  ASSERT_TRUE(game.move(*d4));
+  EXPECT_EQ(game.uciMoves().size(), 2);
+  EXPECT_NE(game, chesscxx::Game());
+
+  game.undoNullMove();
+  EXPECT_EQ(game.uciMoves().size(), 2);
+
+  game.undoMove();
+  game.undoMove();
+  EXPECT_EQ(game.currentPosition(), after_e4);
+  EXPECT_EQ(game.uciMoves().size(), 1);
+
+  game.undoMove();
+  EXPECT_EQ(game, chesscxx::Game());
+}
+
+namespace {
+auto uciMoves(std::initializer_list<std::string_view> moves) {
+  std::vector<chesscxx::UciMove> parsed;
+  for (auto move : moves) {
+    parsed.push_back(chesscxx::parse<chesscxx::UciMove>(move).value());
+  }
+  return parsed;
+}
+
+auto replay(const chesscxx::Position& initial_position,
+            const std::vector<chesscxx::UciMove>& moves) {
+  chesscxx::Game game(initial_position);
+  for (const auto& move : moves) EXPECT_TRUE(game.move(move));
+  return game;
+}
+
+void expectSameState(const chesscxx::Game& game,
+                     const chesscxx::Game& expected) {
+  EXPECT_EQ(game, expected);
+  EXPECT_EQ(game.currentPosition(), expected.currentPosition());
+  EXPECT_EQ(game.sanMoves(), expected.sanMoves());
+  EXPECT_EQ(game.repetitionTracker(), expected.repetitionTracker());
+  EXPECT_EQ(game.startsFromDefaultPosition(),
+            expected.startsFromDefaultPosition());
+}
+}  // namespace
+
+TEST(GameTest, SyncToFollowsMovesAddedAndTakenBack) {
+  chesscxx::Position const start;
+  chesscxx::Game game;
+
+  auto moves = uciMoves({"g1f3", "g8f6", "f3g1", "f6g8", "g1f3"});
+  ASSERT_TRUE(game.syncTo(start, moves));
+  expectSameState(game, replay(start, moves));
+
+  moves = uciMoves({"g1f3", "g8f6", "f3g1", "f6g8", "g1f3", "g8f6", "f3g1"});
+  ASSERT_TRUE(game.syncTo(start, moves));
+  expectSameState(game, replay(start, moves));
+
+  moves = uciMoves({"g1f3", "g8f6", "e2e4"});
+  ASSERT_TRUE(game.syncTo(start, moves));
+  expectSameState(game, replay(start, moves));
+
+  ASSERT_TRUE(game.syncTo(start, {}));
+  expectSameState(game, chesscxx::Game());
+}
+
+TEST(GameTest, SyncToReplaysFromANewInitialPosition) {
+  auto initial_position = chesscxx::parse<chesscxx::Position>(
+      "4k3/8/8/8/8/8/4P3/4K3 w - - 0 1");
+  ASSERT_TRUE(initial_position);
+  chesscxx::Game game;
+  ASSERT_TRUE(game.syncTo(chesscxx::Position(), uciMoves({"e2e4"})));
+
+  auto moves = uciMoves({"e2e4", "e8d7"});
+  ASSERT_TRUE(game.syncTo(*initial_position, moves));
+  expectSameState(game, replay(*initial_position, moves));
+}
+
+TEST(GameTest, SyncToUndoesNullMoves) {
+  chesscxx::Game game;
+  ASSERT_TRUE(game.move(chesscxx::parse<chesscxx::UciMove>("e2e4").value()));
+  ASSERT_TRUE(game.makeNullMove());
+
+  auto moves = uciMoves({"e2e4", "e7e5"});
+  ASSERT_TRUE(game.syncTo(chesscxx::Position(), moves));
+  expectSameState(game, replay(chesscxx::Position(), moves));
+}
+
+TEST(GameTest, SyncToStopsAtAnIllegalMove) {
+  chesscxx::Game game;
+
+  auto result = game.syncTo(chesscxx::Position(),
+                            uciMoves({"e2e4", "e7e5", "e4e5", "g1f3"}));
+  ASSERT_FALSE(result);
+  EXPECT_EQ(result.error(), chesscxx::MoveError::kIllegalMove);
+  expectSameState(game,
+                  replay(chesscxx::Position(), uciMoves({"e2e4", "e7e5"})));
+}
+
+TEST(GameTest, ZobristKeysFollowThePositions) {
+  chesscxx::Game game;
+  auto moves = uciMoves({"e2e4", "e7e5"});
+  ASSERT_TRUE(game.syncTo(chesscxx::Position(), moves));
+  ASSERT_TRUE(game.makeNullMove());
+  EXPECT_EQ(game.zobristKeys().size(), 4);
+  EXPECT_EQ(game.zobristKeys().back(), game.currentPosition().zobristKey());
+
+  game.undoMove();
+  game.undoMove();
+  EXPECT_EQ(game.zobristKeys().size(), 2);
+  EXPECT_EQ(game.zobristKeys().back(), game.currentPosition().zobristKey());
+
+  game.reset();
+  ASSERT_EQ(game.zobristKeys().size(), 1);
+  EXPECT_EQ(game.zobristKeys().front(), chesscxx::Position().zobristKey());
+}
+
+TEST(GameTest, ConsecutiveNullMovesRepeatNoPosition) {
+  chesscxx::Game game;
+  ASSERT_TRUE(game.syncTo(chesscxx::Position(),
+                          uciMoves({"g1f3", "g8f6", "f3g1", "f6g8"})));
+  auto tracker = game.repetitionTracker();
+
+  // The second null move brings back the position before the first one.
+  ASSERT_TRUE(game.makeNullMove());
+  ASSERT_TRUE(game.makeNullMove());
+  EXPECT_EQ(game.zobristKeys().back(), game.zobristKeys().at(4));
+  EXPECT_EQ(game.pliesSinceNullMove(), 0);
+  EXPECT_EQ(game.repetitionTracker(), tracker);
+  EXPECT_EQ(game.result(), std::nullopt);
+
+  ASSERT_TRUE(game.move(chesscxx::parse<chesscxx::UciMove>("g1f3").value()));
+  EXPECT_EQ(game.pliesSinceNullMove(), 1);
+  EXPECT_EQ(game.repetitionTracker(), tracker);
+
+  game.undoMove();
+  game.undoMove();
+  game.undoMove();
+  EXPECT_EQ(game.repetitionTracker(), tracker);
+  EXPECT_EQ(game.pliesSinceNullMove(), 4);
+}
+
+TEST(GameTest, UpcomingRepetitionNeedsTwoEarlierOccurrences) {
+  chesscxx::Game game;
+  EXPECT_FALSE(chesscxx::hasUpcomingRepetition(game));
+
+  // Ng8 would repeat the initial position once, Ng1 the one after Nf3.
+  ASSERT_TRUE(game.syncTo(chesscxx::Position(),
+                          uciMoves({"g1f3", "g8f6", "f3g1"})));
+  EXPECT_FALSE(chesscxx::hasUpcomingRepetition(game));
+  EXPECT_FALSE(chesscxx::hasUpcomingRepetition(game, 3));
+  EXPECT_TRUE(chesscxx::hasUpcomingRepetition(game, 4));
+
+  ASSERT_TRUE(game.syncTo(
+      chesscxx::Position(),
+      uciMoves({"g1f3", "g8f6", "f3g1", "f6g8", "g1f3", "g8f6", "f3g1"})));
+  EXPECT_TRUE(chesscxx::hasUpcomingRepetition(game));
+  EXPECT_EQ(game.result(), std::nullopt);
+}
+
+TEST(GameTest, UpcomingRepetitionIgnoresPositionsBeforePawnMoves) {
+  chesscxx::Game game;
+  ASSERT_TRUE(game.syncTo(
+      chesscxx::Position(),
+      uciMoves({"g1f3", "g8f6", "f3g1", "f6g8", "g1f3", "g8f6", "e2e4"})));
+  EXPECT_FALSE(chesscxx::hasUpcomingRepetition(game, 100));
+}
+
+TEST(GameTest, UpcomingRepetitionIgnoresPositionsBeforeNullMoves) {
+  chesscxx::Game game;
+  ASSERT_TRUE(game.move(chesscxx::parse<chesscxx::UciMove>("g1f3").value()));
+  ASSERT_TRUE(game.makeNullMove());
+  ASSERT_TRUE(game.move(chesscxx::parse<chesscxx::UciMove>("f3g1").value()));
+  ASSERT_TRUE(game.makeNullMove());
+
+  // Nf3 would bring back the position after the first move, but only across
+  // the null moves.
+  EXPECT_FALSE(chesscxx::hasUpcomingRepetition(game, 100));
+}
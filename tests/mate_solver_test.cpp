@@ -0,0 +1,157 @@
+#include <chesscxx/color.h>
+#include <chesscxx/game.h>
+#include <chesscxx/game_result.h>
+#include <chesscxx/position.h>
+#include <chesscxx/search.h>
+#include <chesscxx/uci_move.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "test_helper.h"
+
+namespace {
+using chesscxx::testing::parsePosition;
+using chesscxx::testing::parseUciMove;
+
+auto endsInCheckmate(const chesscxx::Position& position,
+                     const std::vector<chesscxx::UciMove>& line) -> bool {
+  chesscxx::Game game(position);
+  for (const auto& move : line) {
+    if (!game.move(move)) return false;
+  }
+  auto winner = position.activeColor() == chesscxx::Color::kWhite
+                    ? chesscxx::GameResult::kWhiteWins
+                    : chesscxx::GameResult::kBlackWins;
+  return game.result() == winner;
+}
+}  // namespace
+
+TEST(MateSolverTest, ProvesMateInOne) {
+  auto position = parsePosition("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1");
+
+  auto result = chesscxx::solveMate(position, 1, 10000);
+
+  EXPECT_EQ(result.status, chesscxx::MateStatus::kProven);
+  EXPECT_EQ(result.line, std::vector{parseUciMove("a1a8")});
+  EXPECT_EQ(result.mateIn(), 1);
+}
+
+TEST(MateSolverTest, ProvesMateForBlack) {
+  auto position = parsePosition("r5k1/8/8/8/8/8/5PPP/6K1 b - - 0 1");
+
+  auto result = chesscxx::solveMate(position, 3, 10000);
+
+  EXPECT_EQ(result.status, chesscxx::MateStatus::kProven);
+  EXPECT_EQ(result.line, std::vector{parseUciMove("a8a1")});
+}
+
+TEST(MateSolverTest, FindsTheShortestMateAndTheLongestDefense) {
+  auto position = parsePosition("2k5/8/1K6/8/8/8/8/7R w - - 0 1");
+
+  auto result = chesscxx::solveMate(position, 7, 100000);
+
+  EXPECT_EQ(result.status, chesscxx::MateStatus::kProven);
+  EXPECT_EQ(result.mateIn(), 2);
+  EXPECT_EQ(result.plies, 3);
+  EXPECT_TRUE(result.line_complete);
+  EXPECT_TRUE(endsInCheckmate(position, result.line));
+}
+
+TEST(MateSolverTest, ReportsALineCutShortByTheNodeLimit) {
+  auto position = parsePosition("8/8/8/4Q3/7k/4K3/8/8 w - - 0 1");
+
+  // A single bucket cannot keep the proof, and the node limit leaves too few
+  // nodes to search it again while reading the line back.
+  chesscxx::MateSolver solver(64);
+  auto result = solver.solve(position, 7, 10);
+
+  ASSERT_EQ(result.status, chesscxx::MateStatus::kProven);
+  EXPECT_EQ(result.plies, 3);
+  EXPECT_EQ(result.mateIn(), 2);
+  EXPECT_FALSE(result.line_complete);
+  EXPECT_LT(result.line.size(), 3);
+}
+
+TEST(MateSolverTest, ProvesDeeperMates) {
+  auto position = parsePosition("8/8/8/8/8/2k5/7R/1K5R w - - 0 1");
+
+  auto result = chesscxx::solveMate(position, 9, 1000000);
+
+  EXPECT_EQ(result.status, chesscxx::MateStatus::kProven);
+  ASSERT_TRUE(result.mateIn());
+  EXPECT_LE(*result.mateIn(), 5);
+  EXPECT_TRUE(endsInCheckmate(position, result.line));
+}
+
+TEST(MateSolverTest, DisprovesMateBeyondTheLimit) {
+  auto position = parsePosition("2k5/8/1K6/8/8/8/8/7R w - - 0 1");
+
+  auto result = chesscxx::solveMate(position, 2, 100000);
+
+  EXPECT_EQ(result.status, chesscxx::MateStatus::kDisproven);
+  EXPECT_TRUE(result.line.empty());
+  EXPECT_FALSE(result.mateIn());
+}
+
+TEST(MateSolverTest, DisprovesMateFromTheStartingPosition) {
+  chesscxx::Position const position;
+
+  auto result = chesscxx::solveMate(position, 3, 1000000);
+
+  EXPECT_EQ(result.status, chesscxx::MateStatus::kDisproven);
+}
+
+TEST(MateSolverTest, DisprovesMateWithoutLegalMoves) {
+  auto stalemate = parsePosition("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1");
+  auto checkmate = parsePosition("6Rk/6pp/8/8/8/8/8/6K1 b - - 0 1");
+
+  EXPECT_EQ(chesscxx::solveMate(stalemate, 5, 1000).status,
+            chesscxx::MateStatus::kDisproven);
+  EXPECT_EQ(chesscxx::solveMate(checkmate, 5, 1000).status,
+            chesscxx::MateStatus::kDisproven);
+}
+
+TEST(MateSolverTest, GivesUpAtTheNodeLimit) {
+  auto position = parsePosition("8/8/8/8/8/2k5/7R/1K5R w - - 0 1");
+
+  auto result = chesscxx::solveMate(position, 9, 10);
+
+  EXPECT_EQ(result.status, chesscxx::MateStatus::kUnknown);
+  EXPECT_TRUE(result.line.empty());
+}
+
+TEST(MateSolverTest, ReusesItsTableAcrossPositions) {
+  chesscxx::MateSolver solver(size_t{1} << 20U);
+  auto white = parsePosition("6k1/5ppp/8/8/8/8/5PPP/R5K1 w - - 0 1");
+  auto black = parsePosition("r5k1/5ppp/8/8/8/8/5PPP/6K1 b - - 0 1");
+
+  EXPECT_EQ(solver.solve(white, 3, 10000).status,
+            chesscxx::MateStatus::kProven);
+  EXPECT_EQ(solver.solve(black, 3, 10000).status,
+            chesscxx::MateStatus::kProven);
+  EXPECT_EQ(solver.solve(white, 3, 10000).line,
+            std::vector{parseUciMove("a1a8")});
+}
+
+TEST(MateSolverTest, SolvesPositionsInParallel) {
+  std::vector<chesscxx::Position> const positions = {
+      parsePosition("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1"),
+      parsePosition("2k5/8/1K6/8/8/8/8/7R w - - 0 1"),
+      chesscxx::Position(),
+      parsePosition("r5k1/8/8/8/8/8/5PPP/6K1 b - - 0 1"),
+      parsePosition("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1"),
+  };
+
+  auto results = chesscxx::solveMates(positions, 3, 100000, 3, size_t{1}
+                                                                  << 20U);
+
+  ASSERT_EQ(results.size(), positions.size());
+  for (size_t i = 0; i < positions.size(); ++i) {
+    auto expected = chesscxx::solveMate(positions.at(i), 3, 100000);
+    EXPECT_EQ(results.at(i).status, expected.status);
+    EXPECT_EQ(results.at(i).line, expected.line);
+  }
+  EXPECT_TRUE(chesscxx::solveMates({}, 3, 100000).empty());
+}
@@ -3,6 +3,7 @@
 #include <chesscxx/movegen.h>
 #include <chesscxx/parse.h>
 #include <chesscxx/piece_type.h>
+#include <chesscxx/position.h>
 #include <chesscxx/rank.h>
 #include <chesscxx/san_move.h>
 #include <chesscxx/square.h>
@@ -10,12 +11,17 @@
 #include <gtest/gtest.h>
 #include <yaml-cpp/yaml.h>
 
+#include <array>
+#include <cstddef>
 #include <format>
+#include <limits>
 #include <magic_enum/magic_enum.hpp>
+#include <memory_resource>
 #include <ostream>
 #include <ranges>
 #include <string_view>
 #include <unordered_set>
+#include <variant>
 #include <vector>
 
 #include "test_helper.h"  // IWYU pragma: keep
@@ -91,6 +97,30 @@ struct YAML::convert<MovegenFixture> {
   }
 };
 
+struct SeeFixture {
+  chesscxx::Position position;
+  chesscxx::UciMove move;
+  int value = 0;
+
+  friend void PrintTo(const SeeFixture& fixture, std::ostream* output) {
+    *output << std::format("{} {} {}", fixture.position, fixture.move,
+                           fixture.value);
+  }
+};
+
+template <>
+struct YAML::convert<SeeFixture> {
+  static auto decode(const Node& node, SeeFixture& rhs) -> bool {
+    rhs.position =
+        chesscxx::parse<chesscxx::Position>(node[0].as<std::string>()).value();
+    rhs.move =
+        chesscxx::parse<chesscxx::UciMove>(node[1].as<std::string>()).value();
+    rhs.value = node[2].as<int>();
+
+    return true;
+  }
+};
+
 namespace {
 auto GetConfig() { return YAML::LoadFile("data/movegen.yaml"); }
 
@@ -101,6 +131,10 @@ auto GetMovegenFixtures() {
 auto GetOverflowMovegenFixtures() {
   return GetConfig()["overflow_fixtures"].as<std::vector<MovegenFixture>>();
 }
+
+auto GetSeeFixtures() {
+  return GetConfig()["see_fixtures"].as<std::vector<SeeFixture>>();
+}
 }  // namespace
 
 class MovegenSuite : public ::testing::TestWithParam<MovegenFixture> {};
@@ -111,6 +145,10 @@ class OverflowMovegenSuite : public ::testing::TestWithParam<MovegenFixture> {};
 INSTANTIATE_TEST_SUITE_P(MovegenTest, OverflowMovegenSuite,
                          ::testing::ValuesIn(GetOverflowMovegenFixtures()));
 
+class SeeSuite : public ::testing::TestWithParam<SeeFixture> {};
+INSTANTIATE_TEST_SUITE_P(MovegenTest, SeeSuite,
+                         ::testing::ValuesIn(GetSeeFixtures()));
+
 TEST_P(MovegenSuite, GenerateLegalMovesCorrectly) {
   const auto& fixture = GetParam();
 
@@ -133,6 +171,172 @@ TEST_P(MovegenSuite, GenerateLegalMovesCorrectly) {
   EXPECT_TRUE(uci_moves.empty());
 }
 
+TEST_P(MovegenSuite, GenerateLegalMovesFromMemoryResourceCorrectly) {
+  const auto& fixture = GetParam();
+
+  std::array<std::byte, 4096> buffer{};
+  std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+  chesscxx::testing::CountingMemoryResource resource(&arena);
+
+  auto san_moves = fixture.san_moves();
+
+  for (auto move : chesscxx::legalSanMoves(fixture.game(), &resource)) {
+    EXPECT_TRUE(san_moves.contains(move)) << std::format("missing {}", move);
+    san_moves.erase(move);
+  }
+
+  EXPECT_TRUE(san_moves.empty());
+  EXPECT_GE(resource.allocations(), 1);
+
+  arena.release();
+  auto san_allocations = resource.allocations();
+
+  auto uci_moves = fixture.uci_moves();
+
+  for (auto move : chesscxx::legalUciMoves(fixture.game(), &resource)) {
+    EXPECT_TRUE(uci_moves.contains(move)) << std::format("missing {}", move);
+    uci_moves.erase(move);
+  }
+
+  EXPECT_TRUE(uci_moves.empty());
+  EXPECT_GT(resource.allocations(), san_allocations);
+}
+
+namespace {
+// 0 for captures and promotions, 1 for quiet moves and 2 for castlings.
+auto MoveStage(chesscxx::Game game, const chesscxx::UciMove& move) -> int {
+  if (!game.move(move)) return -1;
+
+  const auto& san_move = game.sanMoves().back();
+  const auto* normal_move = std::get_if<chesscxx::SanNormalMove>(&san_move);
+  if (normal_move == nullptr) return 2;
+
+  return (normal_move->is_capture || normal_move->promotion) ? 0 : 1;
+}
+
+auto GivesCheck(chesscxx::Game game, const chesscxx::UciMove& move) -> bool {
+  if (!game.move(move)) return false;
+
+  return std::visit(
+      [](const auto& san_move) { return san_move.check_indicator.has_value(); },
+      game.sanMoves().back());
+}
+
+// The fixtures start from the initial position, so the side to move is in
+// check exactly when the last move carries a check indicator.
+auto IsCheck(const chesscxx::Game& game) -> bool {
+  if (game.sanMoves().empty()) return false;
+
+  return std::visit(
+      [](const auto& san_move) { return san_move.check_indicator.has_value(); },
+      game.sanMoves().back());
+}
+}  // namespace
+
+TEST_P(MovegenSuite, GenerateStagedLegalMovesCorrectly) {
+  const auto& fixture = GetParam();
+  const auto& game = fixture.game();
+
+  auto uci_moves = fixture.uci_moves();
+  int previous_stage = 0;
+
+  for (auto move : chesscxx::stagedLegalUciMoves(game)) {
+    EXPECT_TRUE(uci_moves.contains(move)) << std::format("missing {}", move);
+    uci_moves.erase(move);
+
+    auto stage = MoveStage(game, move);
+    EXPECT_GE(stage, previous_stage) << std::format("{}", move);
+    previous_stage = stage;
+  }
+
+  EXPECT_TRUE(uci_moves.empty());
+}
+
+TEST_P(MovegenSuite, GenerateScoredStagedLegalMovesCorrectly) {
+  const auto& fixture = GetParam();
+  const auto& game = fixture.game();
+
+  auto uci_moves = fixture.uci_moves();
+  int previous_stage = 0;
+  int previous_score = std::numeric_limits<int>::max();
+
+  for (auto move :
+       chesscxx::stagedLegalUciMoves(game, chesscxx::mvvLvaScore)) {
+    EXPECT_TRUE(uci_moves.contains(move)) << std::format("missing {}", move);
+    uci_moves.erase(move);
+
+    auto stage = MoveStage(game, move);
+    EXPECT_GE(stage, previous_stage) << std::format("{}", move);
+    previous_stage = stage;
+
+    if (stage != 0) continue;
+
+    auto score = chesscxx::mvvLvaScore(game.currentPosition(), move);
+    EXPECT_LE(score, previous_score) << std::format("{}", move);
+    previous_score = score;
+  }
+
+  EXPECT_TRUE(uci_moves.empty());
+}
+
+TEST_P(MovegenSuite, GenerateLegalMovesByTypeCorrectly) {
+  using chesscxx::GenType;
+
+  const auto& fixture = GetParam();
+  const auto& game = fixture.game();
+
+  auto uci_moves = fixture.uci_moves();
+
+  for (auto move : chesscxx::legalUciMoves<GenType::kCaptures>(game)) {
+    EXPECT_TRUE(uci_moves.contains(move)) << std::format("missing {}", move);
+    EXPECT_EQ(MoveStage(game, move), 0) << std::format("{}", move);
+    uci_moves.erase(move);
+  }
+
+  for (auto move : chesscxx::legalUciMoves<GenType::kQuiets>(game)) {
+    EXPECT_TRUE(uci_moves.contains(move)) << std::format("missing {}", move);
+    EXPECT_GT(MoveStage(game, move), 0) << std::format("{}", move);
+    uci_moves.erase(move);
+  }
+
+  EXPECT_TRUE(uci_moves.empty());
+
+  bool const is_check = IsCheck(game);
+  auto evasions = fixture.uci_moves();
+
+  for (auto move : chesscxx::legalUciMoves<GenType::kEvasions>(game)) {
+    EXPECT_TRUE(is_check) << std::format("{}", move);
+    EXPECT_TRUE(evasions.contains(move)) << std::format("missing {}", move);
+    evasions.erase(move);
+  }
+
+  if (is_check) EXPECT_TRUE(evasions.empty());
+
+  auto quiet_checks = chesscxx::legalUciMoves<GenType::kQuiets>(game) |
+                      std::views::filter([&game](const auto& move) {
+                        return GivesCheck(game, move);
+                      }) |
+                      std::ranges::to<std::unordered_set<chesscxx::UciMove>>();
+
+  for (auto move : chesscxx::legalUciMoves<GenType::kQuietChecks>(game)) {
+    EXPECT_TRUE(quiet_checks.contains(move))
+        << std::format("missing {}", move);
+    quiet_checks.erase(move);
+  }
+
+  EXPECT_TRUE(quiet_checks.empty());
+}
+
+TEST_P(MovegenSuite, DetectChecksWithoutMakingMoves) {
+  const auto& game = GetParam().game();
+
+  for (auto move : chesscxx::legalUciMoves(game)) {
+    EXPECT_EQ(chesscxx::givesCheck(game.currentPosition(), move),
+              GivesCheck(game, move))
+        << std::format("{}", move);
+  }
+}
+
 TEST_P(MovegenSuite, GeneratedLegalMovesAndLegalMovesAreConsistent) {
   const auto& fixture = GetParam();
 
@@ -148,6 +352,22 @@ TEST_P(MovegenSuite, GeneratedLegalMovesAndLegalMovesAreConsistent) {
   }
 }
 
+TEST_P(MovegenSuite, ValidateMovesWithoutGeneratingThem) {
+  const auto& fixture = GetParam();
+
+  const auto& uci_moves = fixture.uci_moves();
+  const auto& position = fixture.game().currentPosition();
+
+  for (const auto& move : kUciMoves) {
+    EXPECT_EQ(chesscxx::isLegal(position, move), uci_moves.contains(move))
+        << std::format("{:fen} {}", position, move);
+    if (uci_moves.contains(move)) {
+      EXPECT_TRUE(chesscxx::isPseudoLegal(position, move))
+          << std::format("{:fen} {}", position, move);
+    }
+  }
+}
+
 TEST_P(OverflowMovegenSuite, GenerateLegalMovesCorrectly) {
   const auto& fixture = GetParam();
 
@@ -169,3 +389,25 @@ TEST_P(OverflowMovegenSuite, GenerateLegalMovesCorrectly) {
 
   EXPECT_TRUE(uci_moves.empty());
 }
+
+TEST_P(SeeSuite, EvaluateStaticExchangeCorrectly) {
+  const auto& fixture = GetParam();
+
+  EXPECT_EQ(chesscxx::see(fixture.position, fixture.move), fixture.value);
+  EXPECT_TRUE(chesscxx::seeGreaterOrEqual(fixture.position, fixture.move,
+                                          fixture.value));
+  EXPECT_FALSE(chesscxx::seeGreaterOrEqual(fixture.position, fixture.move,
+                                           fixture.value + 1));
+}
+
+TEST_P(MovegenSuite, StaticExchangeAndThresholdAreConsistent) {
+  const auto& position = GetParam().game().currentPosition();
+
+  for (auto move : chesscxx::legalUciMoves(GetParam().game())) {
+    auto value = chesscxx::see(position, move);
+    EXPECT_TRUE(chesscxx::seeGreaterOrEqual(position, move, value))
+        << std::format("{}", move);
+    EXPECT_FALSE(chesscxx::seeGreaterOrEqual(position, move, value + 1))
+        << std::format("{}", move);
+  }
+}
@@ -0,0 +1,87 @@
+#include <chesscxx/game.h>
+#include <chesscxx/pawn_hash_table.h>
+#include <chesscxx/position.h>
+#include <chesscxx/uci_move.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string_view>
+
+#include "test_helper.h"
+
+namespace {
+using chesscxx::testing::parsePosition;
+using chesscxx::testing::parseUciMove;
+
+void move(chesscxx::Game& game, std::string_view str) {
+  ASSERT_TRUE(game.move(parseUciMove(str)));
+}
+}  // namespace
+
+TEST(PawnHashTableTest, IsEmptyAfterConstruction) {
+  chesscxx::PawnHashTable<int, 16> const table;
+
+  EXPECT_EQ(table.size(), 16);
+  EXPECT_EQ(table.probe(0), nullptr);
+  EXPECT_EQ(table.probe(chesscxx::Position{}), nullptr);
+}
+
+TEST(PawnHashTableTest, ProbeReturnsStoredEntry) {
+  chesscxx::PawnHashTable<int, 16> table;
+  chesscxx::Position const position;
+
+  table.store(position, 42);
+
+  ASSERT_NE(table.probe(position), nullptr);
+  EXPECT_EQ(*table.probe(position), 42);
+  EXPECT_EQ(*table.probe(position.pawnKey()), 42);
+}
+
+TEST(PawnHashTableTest, ProbeMissesKeysSharingASlot) {
+  chesscxx::PawnHashTable<int, 16> table;
+  uint64_t const key = 0x1234;
+
+  table.store(key, 1);
+  EXPECT_EQ(table.probe(key + 16), nullptr);
+
+  table.store(key + 16, 2);
+  EXPECT_EQ(table.probe(key), nullptr);
+  ASSERT_NE(table.probe(key + 16), nullptr);
+  EXPECT_EQ(*table.probe(key + 16), 2);
+}
+
+TEST(PawnHashTableTest, ClearRemovesAllEntries) {
+  chesscxx::PawnHashTable<int, 16> table;
+
+  table.store(0, 1);
+  table.store(1, 2);
+  table.clear();
+
+  EXPECT_EQ(table.probe(0), nullptr);
+  EXPECT_EQ(table.probe(1), nullptr);
+}
+
+TEST(PawnHashTableTest, EntryIsSharedByPositionsWithTheSamePawns) {
+  chesscxx::PawnHashTable<int, 1024> table;
+  chesscxx::Game game;
+
+  table.store(game.currentPosition(), 7);
+  move(game, "g1f3");
+  move(game, "b8c6");
+  ASSERT_NE(table.probe(game.currentPosition()), nullptr);
+  EXPECT_EQ(*table.probe(game.currentPosition()), 7);
+
+  move(game, "e2e4");
+  EXPECT_EQ(table.probe(game.currentPosition()), nullptr);
+}
+
+TEST(PawnHashTableTest, PawnKeyIgnoresEverythingButPawns) {
+  auto position = parsePosition("4k3/p7/8/8/8/8/P7/4K3 w - - 0 1");
+
+  EXPECT_EQ(position.pawnKey(),
+            parsePosition("r3k3/p7/8/8/8/8/P7/R3K3 b Qq - 3 9").pawnKey());
+  EXPECT_NE(position.pawnKey(),
+            parsePosition("4k3/p7/8/8/8/P7/8/4K3 w - - 0 1").pawnKey());
+  EXPECT_NE(position.pawnKey(),
+            parsePosition("4k3/P7/8/8/8/8/p7/4K3 w - - 0 1").pawnKey());
+}
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <expected>
 #include <format>
 #include <functional>
@@ -282,6 +283,7 @@ TEST_P(NoLegalEnPassantInputSuite, IsEquivalentWhenEnPassantIsCleared) {
             chesscxx::RepetitionHash{}(*without_en_passant));
   EXPECT_EQ(std::format("{:rep}", *with_en_passant),
             std::format("{:rep}", *without_en_passant));
+  EXPECT_EQ(with_en_passant->zobristKey(), without_en_passant->zobristKey());
 }
 
 TEST_P(LegalEnPassantInputSuite, IsDifferentWhenEnPassantIsCleared) {
@@ -306,6 +308,7 @@ TEST_P(LegalEnPassantInputSuite, IsDifferentWhenEnPassantIsCleared) {
             chesscxx::RepetitionHash{}(*without_en_passant));
   EXPECT_NE(std::format("{:rep}", *with_en_passant),
             std::format("{:rep}", *without_en_passant));
+  EXPECT_NE(with_en_passant->zobristKey(), without_en_passant->zobristKey());
 }
 
 TEST_P(ValidInputPairSuite, ComparesUnequal) {
@@ -392,6 +395,21 @@ TEST(PositionRepetitionTest, HashProducesFewCollisions) {
   });
 }
 
+TEST(PositionTest, ZobristKeyProducesFewCollisions) {
+  // Adjust based on expectations for the test set.
+  constexpr int kMaxCollisions = 1;
+  std::unordered_map<uint64_t, std::vector<chesscxx::Position>> key_counter;
+
+  std::ranges::for_each(GetRepetitionInputs(), [&](const auto& fixture) {
+    const auto& position = fixture.position();
+    auto key = position.zobristKey();
+    key_counter[key].push_back(position);
+    auto collisions = key_counter[key].size();
+    EXPECT_LE(collisions, kMaxCollisions)
+        << std::format("position={}, key_counter={}", position, key_counter);
+  });
+}
+
 TEST(PositionTest, FormatComplexInputCorrectly) {
   auto complex = GetComplexInput();
   const auto& position = complex.position();
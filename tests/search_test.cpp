@@ -0,0 +1,186 @@
+#include <chesscxx/game.h>
+#include <chesscxx/movegen.h>
+#include <chesscxx/position.h>
+#include <chesscxx/search.h>
+#include <chesscxx/uci_move.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "test_helper.h"
+
+namespace {
+using chesscxx::testing::parsePosition;
+using chesscxx::testing::parseUciMove;
+
+auto isLegalLine(chesscxx::Game game, const std::vector<chesscxx::UciMove>& pv)
+    -> bool {
+  return std::ranges::all_of(
+      pv, [&game](const auto& move) { return game.move(move).has_value(); });
+}
+}  // namespace
+
+TEST(SearchTest, FindsMateInOne) {
+  chesscxx::Game game(parsePosition("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1"));
+
+  auto result = chesscxx::search(game, {.depth = 3});
+
+  EXPECT_EQ(result.best_move, parseUciMove("a1a8"));
+  EXPECT_EQ(result.score, chesscxx::kMateScore - 1);
+  EXPECT_EQ(result.mateIn(), 1);
+}
+
+TEST(SearchTest, FindsMateInTwo) {
+  chesscxx::Game game(parsePosition("2k5/8/1K6/8/8/8/8/7R w - - 0 1"));
+
+  auto result = chesscxx::search(game, {.depth = 5});
+
+  EXPECT_EQ(result.mateIn(), 2);
+  EXPECT_TRUE(isLegalLine(game, result.pv));
+  ASSERT_EQ(result.pv.size(), 3);
+  game.move(result.pv.at(0)).value();
+  game.move(result.pv.at(1)).value();
+  game.move(result.pv.at(2)).value();
+  EXPECT_EQ(game.result(), chesscxx::GameResult::kWhiteWins);
+}
+
+TEST(SearchTest, ReportsBeingMated) {
+  chesscxx::Game game(parsePosition("k7/8/1K6/8/8/8/8/7R b - - 0 1"));
+
+  auto result = chesscxx::search(game, {.depth = 4});
+
+  ASSERT_TRUE(result.best_move);
+  EXPECT_EQ(result.mateIn(), -1);
+}
+
+TEST(SearchTest, WinsHangingMaterial) {
+  chesscxx::Game game(parsePosition("4k3/8/8/3q4/8/8/3R4/4K3 w - - 0 1"));
+
+  auto result = chesscxx::search(game, {.depth = 3});
+
+  EXPECT_EQ(result.best_move, parseUciMove("d2d5"));
+  EXPECT_GT(result.score, 0);
+}
+
+TEST(SearchTest, ReturnsNoMoveWithoutLegalMoves) {
+  chesscxx::Game game(parsePosition("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1"));
+
+  auto result = chesscxx::search(game, {.depth = 3});
+
+  EXPECT_FALSE(result.best_move);
+  EXPECT_TRUE(result.pv.empty());
+  EXPECT_EQ(result.score, 0);
+}
+
+TEST(SearchTest, StopsAtDepthLimit) {
+  chesscxx::Game const game;
+  std::vector<int> depths;
+
+  chesscxx::Searcher<> searcher;
+  auto result = searcher.search(
+      game, {.depth = 3},
+      [&depths](const auto& iteration) { depths.push_back(iteration.depth); });
+
+  EXPECT_EQ(depths, (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(result.depth, 3);
+  EXPECT_TRUE(isLegalLine(game, result.pv));
+}
+
+TEST(SearchTest, StopsAtNodeLimit) {
+  chesscxx::Game const game;
+
+  auto result = chesscxx::search(game, {.nodes = 2000});
+
+  ASSERT_TRUE(result.best_move);
+  EXPECT_GE(result.nodes, 2000);
+  EXPECT_LT(result.nodes, 4000);
+}
+
+TEST(SearchTest, StopIsHonoredFromAnotherThread) {
+  chesscxx::Game const game;
+  chesscxx::Searcher<> searcher;
+
+  std::thread stopper([&searcher] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    searcher.stop();
+  });
+  auto result = searcher.search(game, {});
+  stopper.join();
+
+  EXPECT_TRUE(result.best_move);
+  EXPECT_LT(result.depth, 64);
+}
+
+TEST(SearchTest, StopBeforeTheSearchStartsIsHonored) {
+  chesscxx::Game const game;
+  chesscxx::Searcher<> searcher;
+
+  searcher.stop();
+  auto result = searcher.search(game, {});
+  EXPECT_TRUE(result.best_move);
+  EXPECT_EQ(result.depth, 1);
+
+  // That search used the stop up.
+  result = searcher.search(game, {.depth = 3});
+  EXPECT_EQ(result.depth, 3);
+}
+
+TEST(SearchTest, ClearStopWithdrawsAStop) {
+  chesscxx::Game const game;
+  chesscxx::Searcher<> searcher;
+
+  searcher.stop();
+  searcher.clearStop();
+  auto result = searcher.search(game, {.depth = 3});
+  EXPECT_EQ(result.depth, 3);
+}
+
+TEST(SearchTest, AvoidsRepetitionWhenWinning) {
+  chesscxx::Game game(parsePosition("4k3/8/8/8/8/8/3Q4/4K3 w - - 0 1"));
+  for (auto str : {"d2d3", "e8f7", "d3d2", "f7e8", "d2d3", "e8f7", "d3d2",
+                   "f7e8"}) {
+    ASSERT_TRUE(game.move(parseUciMove(str)));
+  }
+
+  auto result = chesscxx::search(game, {.depth = 3});
+
+  EXPECT_NE(result.best_move, parseUciMove("d2d3"));
+  EXPECT_GT(result.score, 0);
+}
+
+TEST(SearchTest, CustomEvaluationIsUsed) {
+  chesscxx::Game game(parsePosition("4k3/8/8/8/8/8/P7/4K3 w - - 0 1"));
+  // Rewards pushing the a-pawn and ignores everything else.
+  auto evaluate = [](const chesscxx::Position& position) {
+    const auto& pieces = position.piecePlacement().pieceArray();
+    int score = 0;
+    for (size_t i = 0; i < pieces.size(); ++i) {
+      if (pieces.at(i) &&
+          pieces.at(i)->type == chesscxx::PieceType::kPawn) {
+        score = static_cast<int>(8 - (i / 8));
+      }
+    }
+    return position.activeColor() == chesscxx::Color::kWhite ? score : -score;
+  };
+
+  chesscxx::Searcher searcher(evaluate);
+  auto result = searcher.search(game, {.depth = 1});
+
+  EXPECT_EQ(result.best_move, parseUciMove("a2a4"));
+}
+
+TEST(SearchTest, LazySmpFindsTheSameMate) {
+  chesscxx::Game game(parsePosition("2k5/8/1K6/8/8/8/8/7R w - - 0 1"));
+
+  chesscxx::Searcher<> searcher(&chesscxx::materialEvaluation,
+                                chesscxx::Searcher<>::kDefaultHashBytes, 4);
+  auto result = searcher.search(game, {.depth = 5});
+
+  EXPECT_EQ(searcher.numThreads(), 4);
+  EXPECT_EQ(result.mateIn(), 2);
+  EXPECT_TRUE(isLegalLine(game, result.pv));
+}
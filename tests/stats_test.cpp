@@ -0,0 +1,157 @@
+#include <chesscxx/game.h>
+#include <chesscxx/game_result.h>
+#include <chesscxx/movegen.h>
+#include <chesscxx/parse.h>
+#include <chesscxx/position.h>
+#include <chesscxx/stats.h>
+#include <chesscxx/uci_move.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <format>
+#include <memory_resource>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <tuple>
+
+#include "test_helper.h"
+
+static_assert(chesscxx::stats::kEnabled,
+              "stats_test must be built with CHESSCXX_ENABLE_STATS");
+
+class StatsTest : public ::testing::Test {
+ protected:
+  void SetUp() override { chesscxx::stats::reset(); }
+};
+
+TEST_F(StatsTest, CountersStartAtZeroAfterReset) {
+  EXPECT_EQ(chesscxx::stats::snapshot(), chesscxx::stats::Counters{});
+}
+
+TEST_F(StatsTest, GameMoveIsCounted) {
+  chesscxx::Game game;
+  chesscxx::stats::reset();
+
+  ASSERT_TRUE(game.move(chesscxx::parse<chesscxx::UciMove>("e2e4").value()));
+
+  auto counters = chesscxx::stats::snapshot();
+  EXPECT_EQ(counters.game_moves, 1);
+  EXPECT_EQ(counters.position_moves, 1);
+  EXPECT_GE(counters.piece_updates, 2);
+  EXPECT_GE(counters.repetition_probes, 1);
+  EXPECT_GE(counters.attack_queries, 1);
+}
+
+TEST_F(StatsTest, FailedGameMoveIsCounted) {
+  chesscxx::Game game;
+  chesscxx::stats::reset();
+
+  ASSERT_FALSE(game.move(chesscxx::parse<chesscxx::UciMove>("e2e5").value()));
+
+  auto counters = chesscxx::stats::snapshot();
+  EXPECT_EQ(counters.game_moves, 1);
+  EXPECT_EQ(counters.position_moves, 1);
+  EXPECT_EQ(counters.piece_updates, 0);
+}
+
+TEST_F(StatsTest, SyncToPlaysOnlyNewMoves) {
+  std::array const moves = {
+      chesscxx::parse<chesscxx::UciMove>("e2e4").value(),
+      chesscxx::parse<chesscxx::UciMove>("e7e5").value(),
+      chesscxx::parse<chesscxx::UciMove>("g1f3").value(),
+  };
+  chesscxx::Game game;
+  ASSERT_TRUE(game.syncTo(chesscxx::Position(), std::span(moves).first(2)));
+  chesscxx::stats::reset();
+
+  ASSERT_TRUE(game.syncTo(chesscxx::Position(), moves));
+
+  EXPECT_EQ(chesscxx::stats::snapshot().game_moves, 1);
+}
+
+TEST_F(StatsTest, CheckmateIsFoundWithoutMoveGeneration) {
+  chesscxx::Game game;
+  for (auto move : {"f2f3", "e7e5", "g2g4"}) {
+    ASSERT_TRUE(game.move(chesscxx::parse<chesscxx::UciMove>(move).value()));
+  }
+  chesscxx::stats::reset();
+
+  ASSERT_TRUE(game.move(chesscxx::parse<chesscxx::UciMove>("d8h4").value()));
+  EXPECT_EQ(game.result(), chesscxx::GameResult::kBlackWins);
+
+  EXPECT_EQ(chesscxx::stats::snapshot().legal_move_generations, 0);
+}
+
+TEST_F(StatsTest, RepetitionLookupsSkipMoveGeneration) {
+  chesscxx::Game game;
+  for (auto move : {"e2e4", "a7a6", "e4e5", "d7d5"}) {
+    ASSERT_TRUE(game.move(chesscxx::parse<chesscxx::UciMove>(move).value()));
+  }
+  const auto& position = game.currentPosition();
+  ASSERT_TRUE(position.legalEnPassantTargetSquare());
+  chesscxx::stats::reset();
+
+  std::ignore = chesscxx::RepetitionHash{}(position);
+  EXPECT_TRUE(chesscxx::RepetitionEqual{}(position, position));
+  EXPECT_FALSE(std::format("{:rep}", position).empty());
+
+  auto counters = chesscxx::stats::snapshot();
+  EXPECT_EQ(counters.coroutine_frames, 0);
+  EXPECT_EQ(counters.self_check_tests, 0);
+}
+
+TEST_F(StatsTest, MoveGenerationIsCounted) {
+  chesscxx::Game game;
+  chesscxx::stats::reset();
+
+  EXPECT_EQ(std::ranges::distance(chesscxx::legalUciMoves(game)), 20);
+
+  auto counters = chesscxx::stats::snapshot();
+  EXPECT_EQ(counters.legal_move_generations, 1);
+  EXPECT_GE(counters.self_check_tests, 20);
+  EXPECT_GE(counters.coroutine_frames, 1);
+}
+
+TEST_F(StatsTest, MemoryResourceFramesAreCounted) {
+  chesscxx::Game game;
+  std::array<std::byte, 4096> buffer{};
+  std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+  chesscxx::testing::CountingMemoryResource resource(&arena);
+  chesscxx::stats::reset();
+
+  EXPECT_EQ(std::ranges::distance(chesscxx::legalUciMoves(game, &resource)),
+            20);
+
+  auto frames = chesscxx::stats::snapshot().coroutine_frames;
+  EXPECT_GE(frames, 1);
+  EXPECT_EQ(resource.allocations(), frames);
+}
+
+TEST_F(StatsTest, CountersArePerThread) {
+  chesscxx::Game game;
+  chesscxx::stats::reset();
+
+  chesscxx::stats::Counters other_thread_counters;
+  std::thread([&] {
+    chesscxx::Game other_game;
+    chesscxx::stats::reset();
+    std::ignore = other_game.move(
+        chesscxx::parse<chesscxx::UciMove>("e2e4").value());
+    other_thread_counters = chesscxx::stats::snapshot();
+  }).join();
+
+  EXPECT_EQ(other_thread_counters.game_moves, 1);
+  EXPECT_EQ(chesscxx::stats::snapshot(), chesscxx::stats::Counters{});
+}
+
+TEST_F(StatsTest, ResetClearsCounters) {
+  chesscxx::Game game;
+  ASSERT_TRUE(game.move(chesscxx::parse<chesscxx::UciMove>("e2e4").value()));
+  ASSERT_NE(chesscxx::stats::snapshot(), chesscxx::stats::Counters{});
+
+  chesscxx::stats::reset();
+
+  EXPECT_EQ(chesscxx::stats::snapshot(), chesscxx::stats::Counters{});
+}
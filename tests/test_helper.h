@@ -3,7 +3,11 @@
 
 #include <chesscxx/formatter/base_formatter.h>
 #include <chesscxx/hash/internal/hash_combine.h>
+#include <chesscxx/parse.h>
+#include <chesscxx/position.h>
 #include <chesscxx/san_move.h>
+#include <chesscxx/uci_move.h>
+#include <gtest/gtest.h>
 
 #include <algorithm>
 #include <array>
@@ -11,9 +15,11 @@
 #include <format>
 #include <functional>
 #include <magic_enum/magic_enum.hpp>
+#include <memory_resource>
 #include <optional>
 #include <ostream>
 #include <ranges>
+#include <string_view>
 #include <tuple>
 #include <variant>
 #include <vector>
@@ -76,6 +82,34 @@ constexpr auto make_optional_enum_array() {
   return make_optional_array_from_range(kValues);
 }
 
+// Forwards to another memory resource and counts the allocations it serves,
+// so tests can tell that a caller-supplied resource was actually used.
+class CountingMemoryResource : public std::pmr::memory_resource {
+ public:
+  explicit CountingMemoryResource(std::pmr::memory_resource* upstream)
+      : upstream_(upstream) {}
+
+  auto allocations() const -> size_t { return allocations_; }
+
+ private:
+  auto do_allocate(size_t bytes, size_t alignment) -> void* override {
+    ++allocations_;
+    return upstream_->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+    upstream_->deallocate(pointer, bytes, alignment);
+  }
+
+  auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+      -> bool override {
+    return this == &other;
+  }
+
+  std::pmr::memory_resource* upstream_;
+  size_t allocations_ = 0;
+};
+
 template <typename Range>
 constexpr auto make_distinct_pairs(const Range& range) {
   using T = std::ranges::range_value_t<Range>;
@@ -92,6 +126,19 @@ constexpr auto make_distinct_pairs(const Range& range) {
 
   return pairs;
 }
+
+// Parses a FEN string, failing the test if it holds no valid position.
+inline auto parsePosition(std::string_view fen) -> Position {
+  auto position = parse<Position>(fen);
+  EXPECT_TRUE(position) << fen;
+  return position.value();
+}
+
+inline auto parseUciMove(std::string_view str) -> UciMove {
+  auto move = parse<UciMove>(str);
+  EXPECT_TRUE(move) << str;
+  return move.value();
+}
 }  // namespace testing
 }  // namespace chesscxx
 
@@ -0,0 +1,168 @@
+#include <chesscxx/game.h>
+#include <chesscxx/parse.h>
+#include <chesscxx/position.h>
+#include <chesscxx/transposition_table.h>
+#include <chesscxx/uci_move.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+struct SearchEntry {
+  int16_t score = 0;
+  int16_t depth = 0;
+};
+
+// Its two halves always agree, so a torn entry would show.
+struct CheckedEntry {
+  uint64_t value = 0;
+  uint64_t complement = ~uint64_t{0};
+};
+
+using Table = chesscxx::TranspositionTable<SearchEntry>;
+}  // namespace
+
+TEST(TranspositionTableTest, BucketsFillACacheLine) {
+  EXPECT_EQ(Table::kEntriesPerBucket, 4);
+  EXPECT_EQ(chesscxx::TranspositionTable<CheckedEntry>::kEntriesPerBucket, 2);
+
+  Table const table(1 << 20);
+  EXPECT_EQ(table.numBytes(), 1 << 20);
+  EXPECT_EQ(table.numEntries(), table.numBuckets() * Table::kEntriesPerBucket);
+}
+
+TEST(TranspositionTableTest, SizeIsRoundedDownToAPowerOfTwo) {
+  EXPECT_EQ(Table(1000).numBuckets(), 8);
+  EXPECT_EQ(Table(0).numBuckets(), 1);
+}
+
+TEST(TranspositionTableTest, ProbeReturnsStoredEntry) {
+  Table table(1 << 16);
+  chesscxx::Position const position;
+
+  EXPECT_FALSE(table.probe(position));
+  table.store(position, {.score = 20, .depth = 3});
+
+  auto entry = table.probe(position.zobristKey());
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(entry->score, 20);
+  EXPECT_EQ(entry->depth, 3);
+}
+
+TEST(TranspositionTableTest, StoreReplacesEntryOfTheSameKey) {
+  Table table(1 << 16);
+  uint64_t const key = 0x123456789ABCDEF0;
+
+  table.store(key, {.score = 1, .depth = 1});
+  table.store(key, {.score = 2, .depth = 2});
+
+  ASSERT_TRUE(table.probe(key));
+  EXPECT_EQ(table.probe(key)->score, 2);
+}
+
+TEST(TranspositionTableTest, ProbeMissesKeysSharingABucket) {
+  Table table(Table::kBucketSize);
+  uint64_t const key = 0x123456789ABCDEF0;
+
+  table.store(key, {.score = 1, .depth = 1});
+
+  EXPECT_FALSE(table.probe(key ^ (uint64_t{1} << 40U)));
+}
+
+TEST(TranspositionTableTest, ProbeChecksEveryKeyBit) {
+  Table table(Table::kBucketSize);
+  uint64_t const key = 0x123456789ABCDEF0;
+
+  table.store(key, {.score = 1, .depth = 1});
+
+  for (unsigned bit = 0; bit < 64; ++bit) {
+    EXPECT_FALSE(table.probe(key ^ (uint64_t{1} << bit))) << bit;
+  }
+  EXPECT_TRUE(table.probe(key));
+}
+
+TEST(TranspositionTableTest, FullBucketReplacesOldestThenShallowest) {
+  Table table(Table::kBucketSize);
+  auto key = [](uint64_t i) { return i << 32U; };
+
+  table.store(key(0), {.score = 0, .depth = 1});
+  table.newSearch();
+  for (uint64_t i = 1; i < Table::kEntriesPerBucket; ++i) {
+    table.store(key(i), {.score = 0, .depth = static_cast<int16_t>(10 + i)});
+  }
+
+  table.store(key(10), {});
+  EXPECT_FALSE(table.probe(key(0)));
+  EXPECT_TRUE(table.probe(key(10)));
+
+  table.store(key(11), {});
+  EXPECT_FALSE(table.probe(key(10)));
+  for (uint64_t i = 1; i < Table::kEntriesPerBucket; ++i) {
+    EXPECT_TRUE(table.probe(key(i)));
+  }
+}
+
+TEST(TranspositionTableTest, ClearRemovesAllEntries) {
+  Table table(1 << 16);
+  chesscxx::Game game;
+
+  table.store(game.currentPosition(), {});
+  ASSERT_TRUE(game.move(chesscxx::parse<chesscxx::UciMove>("e2e4").value()));
+  table.store(game.currentPosition(), {});
+  table.clear();
+
+  EXPECT_FALSE(table.probe(game.currentPosition()));
+  EXPECT_FALSE(table.probe(game.initialPosition()));
+  EXPECT_EQ(table.hashfull(), 0);
+}
+
+TEST(TranspositionTableTest, HashfullCountsEntriesOfTheCurrentSearch) {
+  Table table(Table::kBucketSize * 4);
+
+  for (uint64_t i = 0; i < 4; ++i) table.store(i, {});
+  EXPECT_EQ(table.hashfull(), 1000 / Table::kEntriesPerBucket);
+
+  table.newSearch();
+  EXPECT_EQ(table.hashfull(), 0);
+}
+
+TEST(TranspositionTableTest, PrefetchIsHarmless) {
+  Table const table(1 << 16, true);
+
+  table.prefetch(0);
+  table.prefetch(~uint64_t{0});
+  EXPECT_FALSE(table.probe(0));
+}
+
+TEST(TranspositionTableTest, ConcurrentStoresNeverYieldTornEntries) {
+  chesscxx::TranspositionTable<CheckedEntry> table(1 << 10);
+  constexpr uint64_t kNumKeys = 64;
+  constexpr int kNumRounds = 20000;
+
+  std::vector<std::thread> threads;
+  for (uint64_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&table, t] {
+      for (int round = 0; round < kNumRounds; ++round) {
+        for (uint64_t key = 0; key < kNumKeys; ++key) {
+          uint64_t const value = (t << 32U) | static_cast<uint64_t>(round);
+          table.store(key, {.value = value, .complement = ~value});
+        }
+      }
+    });
+  }
+
+  size_t num_torn = 0;
+  for (int round = 0; round < kNumRounds; ++round) {
+    for (uint64_t key = 0; key < kNumKeys; ++key) {
+      if (auto entry = table.probe(key)) {
+        num_torn += static_cast<size_t>(entry->complement != ~entry->value);
+      }
+    }
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_EQ(num_torn, 0);
+}
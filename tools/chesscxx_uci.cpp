@@ -0,0 +1,303 @@
+#include <chesscxx/game.h>
+#include <chesscxx/parse.h>
+#include <chesscxx/position.h>
+#include <chesscxx/search.h>
+#include <chesscxx/uci_move.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <format>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <print>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Splits a command into words in place, without copying them.
+class Tokenizer {
+ public:
+  explicit Tokenizer(std::string_view line) : rest_(line) {}
+
+  auto next() -> std::optional<std::string_view> {
+    auto begin = rest_.find_first_not_of(" \t\r");
+    if (begin == std::string_view::npos) return std::nullopt;
+    rest_.remove_prefix(begin);
+
+    auto end = std::min(rest_.find_first_of(" \t\r"), rest_.size());
+    auto token = rest_.substr(0, end);
+    rest_.remove_prefix(end);
+    return token;
+  }
+
+  // The remaining words, up to but excluding the given one.
+  auto until(std::string_view word) -> std::string_view {
+    auto begin = rest_.find_first_not_of(" \t\r");
+    if (begin == std::string_view::npos) return {};
+    rest_.remove_prefix(begin);
+
+    auto end = std::min(rest_.find(word), rest_.size());
+    auto text = rest_.substr(0, end);
+    rest_.remove_prefix(end);
+    return text.substr(0, text.find_last_not_of(" \t\r") + 1);
+  }
+
+ private:
+  std::string_view rest_;
+};
+
+template <typename T>
+auto parseNumber(std::optional<std::string_view> token) -> std::optional<T> {
+  if (!token) return std::nullopt;
+
+  T value{};
+  auto [end, error] =
+      std::from_chars(token->data(), token->data() + token->size(), value);
+  if (error != std::errc{} || end != token->data() + token->size()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+// Speaks the UCI protocol on stdin and stdout. Commands are read on the main
+// thread while searches run on a worker thread, so `stop` and `isready` are
+// answered during a search.
+class UciEngine {
+ public:
+  static constexpr size_t kDefaultHashMiB = 16;
+  static constexpr size_t kMaxHashMiB = 65536;
+  static constexpr size_t kMaxThreads = 256;
+
+  UciEngine()
+      : searcher_(&chesscxx::materialEvaluation, kDefaultHashMiB << 20U) {}
+
+  UciEngine(const UciEngine&) = delete;
+  UciEngine(UciEngine&&) = delete;
+  auto operator=(const UciEngine&) -> UciEngine& = delete;
+  auto operator=(UciEngine&&) -> UciEngine& = delete;
+
+  ~UciEngine() { stopSearch(); }
+
+  // Returns false once the engine should quit.
+  auto handle(std::string_view line) -> bool {
+    Tokenizer tokens(line);
+    auto command = tokens.next();
+    if (!command) return true;
+
+    if (*command == "uci") {
+      send("id name chesscxx");
+      send("id author chesscxx contributors");
+      send("option name Hash type spin default {} min 1 max {}",
+           kDefaultHashMiB, kMaxHashMiB);
+      send("option name Threads type spin default 1 min 1 max {}",
+           kMaxThreads);
+      send("uciok");
+    } else if (*command == "isready") {
+      send("readyok");
+    } else if (*command == "setoption") {
+      setOption(tokens);
+    } else if (*command == "ucinewgame") {
+      stopSearch();
+      searcher_.clearHash();
+      game_ = chesscxx::Game();
+    } else if (*command == "position") {
+      setPosition(tokens);
+    } else if (*command == "go") {
+      go(tokens);
+    } else if (*command == "stop") {
+      stopSearch();
+    } else if (*command == "quit") {
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  template <typename... Args>
+  void send(std::format_string<Args...> format, Args&&... args) {
+    std::lock_guard const lock(output_mutex_);
+    std::println(format, std::forward<Args>(args)...);
+    std::fflush(stdout);
+  }
+
+  // setoption name <name> value <value>
+  void setOption(Tokenizer& tokens) {
+    if (tokens.next() != "name") return;
+    auto name = tokens.until("value");
+    if (tokens.next() != "value") return;
+    auto value = parseNumber<size_t>(tokens.next());
+    if (!value) return;
+
+    stopSearch();
+    if (name == "Hash") {
+      searcher_.setHashBytes(std::clamp<size_t>(*value, 1, kMaxHashMiB)
+                             << 20U);
+    } else if (name == "Threads") {
+      searcher_.setNumThreads(std::clamp<size_t>(*value, 1, kMaxThreads));
+    }
+  }
+
+  // position (startpos | fen <fen>) [moves <move>...]
+  //
+  // The moves are parsed into a buffer kept from one command to the next,
+  // so even games hundreds of moves long are read without allocating, and
+  // only the moves added since the last command are played.
+  void setPosition(Tokenizer& tokens) {
+    auto kind = tokens.next();
+    chesscxx::Position position;
+    if (kind == "fen") {
+      auto parsed_position =
+          chesscxx::parse<chesscxx::Position>(tokens.until("moves"));
+      if (!parsed_position) {
+        send("info string invalid fen");
+        return;
+      }
+      position = *parsed_position;
+    } else if (kind != "startpos") {
+      return;
+    }
+
+    moves_.clear();
+    if (tokens.next() == "moves") {
+      while (auto token = tokens.next()) {
+        auto move = chesscxx::parse<chesscxx::UciMove>(*token);
+        if (!move) {
+          send("info string invalid move {}", *token);
+          return;
+        }
+        moves_.push_back(*move);
+      }
+    }
+
+    stopSearch();
+    if (!game_.syncTo(position, moves_)) {
+      send("info string illegal move {}",
+           moves_.at(game_.uciMoves().size()));
+    }
+  }
+
+  // go [depth <plies>] [nodes <count>] [movetime <ms>] [wtime <ms>]
+  //    [btime <ms>] [winc <ms>] [binc <ms>] [movestogo <count>] [infinite]
+  void go(Tokenizer& tokens) {
+    stopSearch();
+
+    chesscxx::SearchLimits limits;
+    std::optional<int64_t> time_left;
+    int64_t increment = 0;
+    int64_t moves_to_go = kDefaultMovesToGo;
+    bool infinite = false;
+    bool const white = game_.currentPosition().activeColor() ==
+                       chesscxx::Color::kWhite;
+
+    while (auto token = tokens.next()) {
+      if (*token == "depth") {
+        limits.depth = parseNumber<int>(tokens.next());
+      } else if (*token == "nodes") {
+        limits.nodes = parseNumber<uint64_t>(tokens.next());
+      } else if (*token == "movetime") {
+        if (auto time = parseNumber<int64_t>(tokens.next())) {
+          limits.time = std::chrono::milliseconds(*time);
+        }
+      } else if (*token == (white ? "wtime" : "btime")) {
+        time_left = parseNumber<int64_t>(tokens.next());
+      } else if (*token == (white ? "winc" : "binc")) {
+        increment = parseNumber<int64_t>(tokens.next()).value_or(0);
+      } else if (*token == "movestogo") {
+        moves_to_go = std::max<int64_t>(
+            parseNumber<int64_t>(tokens.next()).value_or(kDefaultMovesToGo),
+            1);
+      } else if (*token == "infinite") {
+        infinite = true;
+      }
+    }
+
+    // Spends an even share of the time left, keeping a margin for the
+    // time the result takes to reach the GUI.
+    if (time_left && !limits.time) {
+      auto budget = (*time_left / moves_to_go) + (increment / 2);
+      budget = std::min(budget, *time_left - kMoveOverheadMs);
+      limits.time = std::chrono::milliseconds(std::max<int64_t>(budget, 1));
+    }
+
+    stop_requested_.store(false);
+    searcher_.clearStop();
+    worker_ = std::thread([this, limits, infinite] {
+      search(limits, infinite);
+    });
+  }
+
+  void search(const chesscxx::SearchLimits& limits, bool infinite) {
+    auto result = searcher_.search(
+        game_, limits,
+        [this](const chesscxx::SearchResult& iteration) { info(iteration); });
+
+    // In infinite mode the GUI expects the best move only after `stop`.
+    if (infinite) stop_requested_.wait(false);
+
+    if (result.best_move) {
+      send("bestmove {}", *result.best_move);
+    } else {
+      send("bestmove 0000");
+    }
+  }
+
+  void info(const chesscxx::SearchResult& iteration) {
+    auto milliseconds = iteration.time.count();
+    auto nps = iteration.nodes * 1000 /
+               static_cast<uint64_t>(std::max<int64_t>(milliseconds, 1));
+
+    std::string score;
+    if (auto mate = iteration.mateIn()) {
+      score = std::format("mate {}", *mate);
+    } else {
+      score = std::format("cp {}", iteration.score);
+    }
+
+    std::string pv;
+    for (const auto& move : iteration.pv) {
+      pv += std::format(" {}", move);
+    }
+
+    send("info depth {} score {} nodes {} nps {} time {} hashfull {} pv{}",
+         iteration.depth, score, iteration.nodes, nps, milliseconds,
+         searcher_.hashfull(), pv);
+  }
+
+  void stopSearch() {
+    if (!worker_.joinable()) return;
+
+    searcher_.stop();
+    stop_requested_.store(true);
+    stop_requested_.notify_one();
+    worker_.join();
+  }
+
+  static constexpr int64_t kDefaultMovesToGo = 30;
+  static constexpr int64_t kMoveOverheadMs = 30;
+
+  chesscxx::Searcher<> searcher_;
+  chesscxx::Game game_;
+  std::vector<chesscxx::UciMove> moves_;
+  std::thread worker_;
+  std::atomic<bool> stop_requested_ = false;
+  std::mutex output_mutex_;
+};
+
+}  // namespace
+
+auto main() -> int {
+  UciEngine engine;
+  std::string line;
+  while (std::getline(std::cin, line) && engine.handle(line)) {
+  }
+}